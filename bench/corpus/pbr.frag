@@ -0,0 +1,177 @@
+#version 450
+
+#define MAX_LIGHTS 16
+#define SHADOW_CASCADES 4
+#define PCF_RADIUS 2
+const float PI = 3.14159265359;
+
+struct Light {
+    vec4 positionRange;  // w = range, 0 for directional
+    vec4 colorIntensity;
+    vec4 directionCone;  // w = cos(outer cone)
+};
+
+layout(set = 0, binding = 1) uniform Lighting {
+    Light lights[MAX_LIGHTS];
+    mat4 cascadeMatrices[SHADOW_CASCADES];
+    vec4 cascadeSplits;
+    vec4 ambient;
+    uint lightCount;
+    float exposure;
+} lighting;
+
+layout(set = 0, binding = 2) uniform sampler2DArrayShadow shadowMap;
+layout(set = 0, binding = 3) uniform samplerCube irradianceMap;
+layout(set = 0, binding = 4) uniform samplerCube prefilterMap;
+layout(set = 0, binding = 5) uniform sampler2D brdfLut;
+
+layout(set = 2, binding = 0) uniform sampler2D albedoMap;
+layout(set = 2, binding = 1) uniform sampler2D normalMap;
+layout(set = 2, binding = 2) uniform sampler2D metallicRoughnessMap;
+layout(set = 2, binding = 3) uniform sampler2D occlusionMap;
+layout(set = 2, binding = 4) uniform sampler2D emissiveMap;
+
+layout(set = 2, binding = 5) uniform Material {
+    vec4 baseColor;
+    vec4 emissive;
+    float metallic;
+    float roughness;
+    float normalScale;
+    float occlusionStrength;
+} material;
+
+layout(location = 0) in vec3 inWorldPos;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec4 inTangent;
+layout(location = 3) in vec2 inUV;
+layout(location = 4) in vec3 inViewDir;
+
+layout(location = 0) out vec4 outColor;
+
+float distribution_ggx(vec3 n, vec3 h, float roughness) {
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float nh = max(dot(n, h), 0.0);
+    float d = nh * nh * (a2 - 1.0) + 1.0;
+    return a2 / (PI * d * d);
+}
+
+float geometry_schlick_ggx(float nv, float roughness) {
+    float r = roughness + 1.0;
+    float k = (r * r) / 8.0;
+    return nv / (nv * (1.0 - k) + k);
+}
+
+float geometry_smith(vec3 n, vec3 v, vec3 l, float roughness) {
+    return geometry_schlick_ggx(max(dot(n, v), 0.0), roughness) * geometry_schlick_ggx(max(dot(n, l), 0.0), roughness);
+}
+
+vec3 fresnel_schlick(float cosTheta, vec3 f0) {
+    return f0 + (1.0 - f0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+vec3 fresnel_schlick_roughness(float cosTheta, vec3 f0, float roughness) {
+    return f0 + (max(vec3(1.0 - roughness), f0) - f0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+vec3 perturb_normal() {
+    vec3 t = normalize(inTangent.xyz);
+    vec3 n = normalize(inNormal);
+    vec3 b = cross(n, t) * inTangent.w;
+    vec3 sampled = texture(normalMap, inUV).xyz * 2.0 - 1.0;
+    sampled.xy *= material.normalScale;
+    return normalize(mat3(t, b, n) * sampled);
+}
+
+float shadow_factor(vec3 worldPos, float viewDepth) {
+    int cascade = 0;
+    for (int i = 0; i < SHADOW_CASCADES - 1; ++i) {
+        if (viewDepth > lighting.cascadeSplits[i])
+            cascade = i + 1;
+    }
+
+    vec4 lightSpace = lighting.cascadeMatrices[cascade] * vec4(worldPos, 1.0);
+    vec3 coord = lightSpace.xyz / lightSpace.w;
+    coord.xy = coord.xy * 0.5 + 0.5;
+
+    vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+    float sum = 0.0;
+    for (int y = -PCF_RADIUS; y <= PCF_RADIUS; ++y) {
+        for (int x = -PCF_RADIUS; x <= PCF_RADIUS; ++x)
+            sum += texture(shadowMap, vec4(coord.xy + vec2(x, y) * texel, float(cascade), coord.z));
+    }
+    float taps = float((2 * PCF_RADIUS + 1) * (2 * PCF_RADIUS + 1));
+    return sum / taps;
+}
+
+vec3 evaluate_light(Light light, vec3 n, vec3 v, vec3 albedo, float metallic, float roughness, vec3 f0) {
+    vec3 l;
+    float attenuation = 1.0;
+    if (light.positionRange.w == 0.0) {
+        l = normalize(-light.directionCone.xyz);
+    } else {
+        vec3 toLight = light.positionRange.xyz - inWorldPos;
+        float dist = length(toLight);
+        l = toLight / dist;
+        float falloff = clamp(1.0 - pow(dist / light.positionRange.w, 4.0), 0.0, 1.0);
+        attenuation = falloff * falloff / (dist * dist + 1.0);
+        if (light.directionCone.w > 0.0) {
+            float cosAngle = dot(-l, normalize(light.directionCone.xyz));
+            attenuation *= smoothstep(light.directionCone.w, mix(light.directionCone.w, 1.0, 0.1), cosAngle);
+        }
+    }
+
+    vec3 h = normalize(v + l);
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a * attenuation;
+
+    float ndf = distribution_ggx(n, h, roughness);
+    float g = geometry_smith(n, v, l, roughness);
+    vec3 f = fresnel_schlick(max(dot(h, v), 0.0), f0);
+
+    vec3 specular = (ndf * g * f) / (4.0 * max(dot(n, v), 0.0) * max(dot(n, l), 0.0) + 0.0001);
+    vec3 kd = (vec3(1.0) - f) * (1.0 - metallic);
+    return (kd * albedo / PI + specular) * radiance * max(dot(n, l), 0.0);
+}
+
+vec3 aces(vec3 x) {
+    const float a = 2.51, b = 0.03, c = 2.43, d = 0.59, e = 0.14;
+    return clamp((x * (a * x + b)) / (x * (c * x + d) + e), 0.0, 1.0);
+}
+
+void main() {
+    vec4 albedoSample = texture(albedoMap, inUV) * material.baseColor;
+    if (albedoSample.a < 0.5)
+        discard;
+
+    vec3 albedo = pow(albedoSample.rgb, vec3(2.2));
+    vec2 mr = texture(metallicRoughnessMap, inUV).bg;
+    float metallic = mr.x * material.metallic;
+    float roughness = clamp(mr.y * material.roughness, 0.04, 1.0);
+    float ao = mix(1.0, texture(occlusionMap, inUV).r, material.occlusionStrength);
+
+    vec3 n = perturb_normal();
+    vec3 v = normalize(inViewDir);
+    vec3 r = reflect(-v, n);
+    vec3 f0 = mix(vec3(0.04), albedo, metallic);
+
+    vec3 lo = vec3(0.0);
+    for (uint i = 0; i < min(lighting.lightCount, uint(MAX_LIGHTS)); ++i) {
+        vec3 contribution = evaluate_light(lighting.lights[i], n, v, albedo, metallic, roughness, f0);
+        if (i == 0)
+            contribution *= shadow_factor(inWorldPos, length(inViewDir));
+        lo += contribution;
+    }
+
+    vec3 f = fresnel_schlick_roughness(max(dot(n, v), 0.0), f0, roughness);
+    vec3 kd = (1.0 - f) * (1.0 - metallic);
+    vec3 diffuse = texture(irradianceMap, n).rgb * albedo;
+    const float maxLod = 4.0;
+    vec3 prefiltered = textureLod(prefilterMap, r, roughness * maxLod).rgb;
+    vec2 brdf = texture(brdfLut, vec2(max(dot(n, v), 0.0), roughness)).rg;
+    vec3 specular = prefiltered * (f * brdf.x + brdf.y);
+    vec3 ambient = (kd * diffuse + specular) * ao * lighting.ambient.rgb;
+
+    vec3 emissive = texture(emissiveMap, inUV).rgb * material.emissive.rgb;
+    vec3 color = aces((ambient + lo + emissive) * lighting.exposure);
+    outColor = vec4(pow(color, vec3(1.0 / 2.2)), albedoSample.a);
+}
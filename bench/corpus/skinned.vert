@@ -0,0 +1,52 @@
+#version 450
+
+#define MAX_BONES 128
+
+layout(set = 0, binding = 0) uniform Camera {
+    mat4 view;
+    mat4 projection;
+    vec3 position;
+} camera;
+
+layout(set = 1, binding = 0) readonly buffer Bones {
+    mat4 bones[];
+};
+
+layout(push_constant) uniform Push {
+    mat4 model;
+    uint boneOffset;
+} push;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec4 inTangent;
+layout(location = 3) in vec2 inUV;
+layout(location = 4) in uvec4 inJoints;
+layout(location = 5) in vec4 inWeights;
+
+layout(location = 0) out vec3 outWorldPos;
+layout(location = 1) out vec3 outNormal;
+layout(location = 2) out vec4 outTangent;
+layout(location = 3) out vec2 outUV;
+layout(location = 4) out vec3 outViewDir;
+
+mat4 skin_matrix() {
+    mat4 skin = mat4(0.0);
+    for (int i = 0; i < 4; ++i)
+        skin += inWeights[i] * bones[push.boneOffset + min(inJoints[i], uint(MAX_BONES - 1))];
+    return skin;
+}
+
+void main() {
+    mat4 world = push.model * skin_matrix();
+    vec4 worldPos = world * vec4(inPosition, 1.0);
+    mat3 normalMatrix = transpose(inverse(mat3(world)));
+
+    outWorldPos = worldPos.xyz;
+    outNormal = normalize(normalMatrix * inNormal);
+    outTangent = vec4(normalize(normalMatrix * inTangent.xyz), inTangent.w);
+    outUV = inUV;
+    outViewDir = camera.position - worldPos.xyz;
+
+    gl_Position = camera.projection * camera.view * worldPos;
+}
@@ -0,0 +1,418 @@
+/*
+* File: shaderpipe_bench
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+// Compile throughput benchmark.
+// Runs glsl_to_spirv, reflect_spirv and spirv_to_glsl over the corpus, once on a single thread and once spread over
+// a thread pool, and writes latency percentiles / throughput per phase as JSON so two versions can be diffed.
+//
+// usage: shaderpipe_bench [--corpus <dir>] [--iterations <n>] [--threads <n>] [--out <file.json>]
+
+#include "shader_pipe.hpp"
+#include "shader_thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef SHADERPIPE_BENCH_CORPUS
+    #define SHADERPIPE_BENCH_CORPUS "bench/corpus"
+#endif
+
+#ifndef SHADERPIPE_VERSION
+    #define SHADERPIPE_VERSION "unknown"
+#endif
+
+using namespace shaderpipe;
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+enum Phase {
+    PHASE_COMPILE,
+    PHASE_REFLECT,
+    PHASE_CROSS,
+    PHASE_COUNT,
+};
+
+constexpr const char* PhaseNames[PHASE_COUNT] = { "glsl_to_spirv", "reflect_spirv", "spirv_to_glsl" };
+
+// Ray tracing and mesh shading need SPIR-V 1.4, target a version that has it for the whole corpus.
+constexpr VKVersion BenchTarget = VKVersion::VK_1_3;
+
+struct StageExtension {
+    const char* extension;
+    ShaderStage stage;
+    const char* name;
+};
+
+constexpr StageExtension StageExtensions[] = {
+    { ".vert",  ShaderStage::VERTEX,       "VERTEX" },
+    { ".tesc",  ShaderStage::TESS_CONTROL, "TESS_CONTROL" },
+    { ".tese",  ShaderStage::TESS_EVAL,    "TESS_EVAL" },
+    { ".geom",  ShaderStage::GEOMETRY,     "GEOMETRY" },
+    { ".frag",  ShaderStage::FRAGMENT,     "FRAGMENT" },
+    { ".comp",  ShaderStage::COMPUTE,      "COMPUTE" },
+    { ".rgen",  ShaderStage::RAYGEN,       "RAYGEN" },
+    { ".rint",  ShaderStage::INTERSECT,    "INTERSECT" },
+    { ".rahit", ShaderStage::ANY_HIT,      "ANY_HIT" },
+    { ".rchit", ShaderStage::CLOSEST_HIT,  "CLOSEST_HIT" },
+    { ".rmiss", ShaderStage::MISS,         "MISS" },
+    { ".rcall", ShaderStage::CALLABLE,     "CALLABLE" },
+    { ".task",  ShaderStage::TASK,         "TASK" },
+    { ".mesh",  ShaderStage::MESH,         "MESH" },
+};
+
+struct BenchShader {
+    std::string name;
+    ShaderStage stage;
+    const char* stageName;
+    std::string source;
+    std::vector<uint32_t> spirv;
+    std::string errors[PHASE_COUNT]; // non empty => the phase is skipped for this shader
+    double singleP50[PHASE_COUNT] = {};
+};
+
+struct PhaseResult {
+    std::vector<double> latenciesUs;
+    double wallMs = 0.0;
+    uint64_t bytes = 0; // input bytes processed
+};
+
+struct RunResult {
+    std::string mode;
+    uint32_t threads;
+    PhaseResult phases[PHASE_COUNT];
+};
+
+// The corpus tops out at a few hundred lines, this one is generated to stand in for a real uber shader.
+std::string generate_uber_shader(int functions) {
+    std::ostringstream s;
+    s << "#version 450\n\n"
+         "layout(set = 0, binding = 0) uniform Params { vec4 values[64]; } params;\n"
+         "layout(set = 0, binding = 1) uniform sampler2D textures[8];\n"
+         "layout(location = 0) in vec2 inUV;\n"
+         "layout(location = 0) out vec4 outColor;\n\n";
+    for (int i = 0; i < functions; ++i) {
+        s << "vec4 layer" << i << "(vec2 uv, vec4 acc) {\n"
+          << "    vec4 p = params.values[" << (i % 64) << "];\n"
+          << "    vec4 t = texture(textures[" << (i % 8) << "], uv * p.xy + p.zw);\n"
+          << "    float w = clamp(dot(t.rgb, vec3(0.299, 0.587, 0.114)) * p.x + " << (i % 7) << ".0 * 0.01, 0.0, 1.0);\n"
+          << "    for (int j = 0; j < " << (1 + i % 4) << "; ++j)\n"
+          << "        acc = mix(acc, t * sin(acc + float(j)), w);\n"
+          << "    return acc + vec4(pow(abs(t.rgb), vec3(p.y + 1.0)), t.a) * " << (1.0 / (i + 1)) << ";\n"
+          << "}\n\n";
+    }
+    s << "void main() {\n    vec4 acc = vec4(0.0);\n";
+    for (int i = 0; i < functions; ++i)
+        s << "    acc = layer" << i << "(inUV, acc);\n";
+    s << "    outColor = acc;\n}\n";
+    return s.str();
+}
+
+std::vector<BenchShader> load_corpus(const fs::path& dir) {
+    std::vector<BenchShader> shaders;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        const auto ext = entry.path().extension().string();
+        auto it = std::find_if(std::begin(StageExtensions), std::end(StageExtensions),
+                               [&](const StageExtension& s) { return ext == s.extension; });
+        if (it == std::end(StageExtensions))
+            continue;
+
+        BenchShader shader;
+        shader.name = entry.path().filename().string();
+        shader.stage = it->stage;
+        shader.stageName = it->name;
+        shader.source = load_shader_file(entry.path().string());
+        shaders.push_back(std::move(shader));
+    }
+
+    BenchShader uber;
+    uber.name = "generated/uber.frag";
+    uber.stage = ShaderStage::FRAGMENT;
+    uber.stageName = "FRAGMENT";
+    uber.source = generate_uber_shader(400);
+    shaders.push_back(std::move(uber));
+
+    // Stable order so runs line up when diffed.
+    std::sort(shaders.begin(), shaders.end(), [](const BenchShader& a, const BenchShader& b) { return a.name < b.name; });
+    return shaders;
+}
+
+// Returns the input size in bytes, for throughput.
+size_t run_phase(Phase phase, const BenchShader& shader) {
+    switch (phase) {
+        case PHASE_COMPILE:
+            glsl_to_spirv(shader.source, shader.stage, BenchTarget);
+            return shader.source.size();
+        case PHASE_REFLECT:
+            reflect_spirv(shader.spirv);
+            return shader.spirv.size() * sizeof(uint32_t);
+        case PHASE_CROSS:
+            spirv_to_glsl(shader.spirv, GlVersion::GL_450);
+            return shader.spirv.size() * sizeof(uint32_t);
+        default:
+            return 0;
+    }
+}
+
+double elapsed_us(Clock::time_point begin, Clock::time_point end) {
+    return std::chrono::duration<double, std::micro>(end - begin).count();
+}
+
+// Untimed pass: produces the SPIR-V the later phases need and finds out which phases a shader does not support
+// (e.g. ray tracing stages have no plain GL equivalent to cross compile to).
+void warm_up(std::vector<BenchShader>& shaders) {
+    for (auto& shader : shaders) {
+        try {
+            shader.spirv = glsl_to_spirv(shader.source, shader.stage, BenchTarget);
+        } catch (const std::exception& e) {
+            for (auto& error : shader.errors)
+                error = e.what();
+            continue;
+        }
+        for (int phase = PHASE_REFLECT; phase < PHASE_COUNT; ++phase) {
+            try {
+                run_phase(static_cast<Phase>(phase), shader);
+            } catch (const std::exception& e) {
+                shader.errors[phase] = e.what();
+            }
+        }
+    }
+}
+
+RunResult run_single(std::vector<BenchShader>& shaders, int iterations) {
+    RunResult run{ "single", 1, {} };
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        auto& result = run.phases[phase];
+        const auto wallBegin = Clock::now();
+        for (auto& shader : shaders) {
+            if (!shader.errors[phase].empty())
+                continue;
+            std::vector<double> samples;
+            samples.reserve(iterations);
+            for (int i = 0; i < iterations; ++i) {
+                const auto begin = Clock::now();
+                result.bytes += run_phase(static_cast<Phase>(phase), shader);
+                samples.push_back(elapsed_us(begin, Clock::now()));
+            }
+            result.latenciesUs.insert(result.latenciesUs.end(), samples.begin(), samples.end());
+
+            std::nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+            shader.singleP50[phase] = samples[samples.size() / 2];
+        }
+        result.wallMs = elapsed_us(wallBegin, Clock::now()) / 1000.0;
+    }
+    return run;
+}
+
+RunResult run_parallel(const std::vector<BenchShader>& shaders, int iterations, ThreadPool& pool) {
+    RunResult run{ "parallel", pool.thread_count(), {} };
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        std::vector<const BenchShader*> jobs;
+        for (const auto& shader : shaders) {
+            if (shader.errors[phase].empty()) {
+                for (int i = 0; i < iterations; ++i)
+                    jobs.push_back(&shader);
+            }
+        }
+
+        auto& result = run.phases[phase];
+        result.latenciesUs.resize(jobs.size());
+        std::vector<size_t> bytes(jobs.size());
+
+        const auto wallBegin = Clock::now();
+        pool.parallel_for(jobs.size(), [&](size_t i) {
+            const auto begin = Clock::now();
+            bytes[i] = run_phase(static_cast<Phase>(phase), *jobs[i]);
+            result.latenciesUs[i] = elapsed_us(begin, Clock::now());
+        });
+        result.wallMs = elapsed_us(wallBegin, Clock::now()) / 1000.0;
+
+        for (size_t b : bytes)
+            result.bytes += b;
+    }
+    return run;
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty())
+        return 0.0;
+    const double rank = p / 100.0 * static_cast<double>(sorted.size() - 1);
+    const size_t lo = static_cast<size_t>(rank);
+    const size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - static_cast<double>(lo));
+}
+
+std::string json_escape(std::string_view str) {
+    std::string out;
+    out.reserve(str.size());
+    for (char c : str) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out;
+}
+
+// Expects the latencies sorted.
+void write_phase(std::ostream& out, const PhaseResult& result) {
+    const auto& lat = result.latenciesUs;
+
+    double sum = 0.0;
+    for (double v : lat)
+        sum += v;
+    const double wallSec = result.wallMs / 1000.0;
+
+    out << "{\"ops\": " << lat.size()
+        << ", \"wall_ms\": " << result.wallMs
+        << ", \"ops_per_sec\": " << (wallSec > 0.0 ? static_cast<double>(lat.size()) / wallSec : 0.0)
+        << ", \"mb_per_sec\": " << (wallSec > 0.0 ? static_cast<double>(result.bytes) / (1024.0 * 1024.0) / wallSec : 0.0)
+        << ", \"latency_us\": {"
+        << "\"min\": " << (lat.empty() ? 0.0 : lat.front())
+        << ", \"p50\": " << percentile(lat, 50.0)
+        << ", \"p90\": " << percentile(lat, 90.0)
+        << ", \"p99\": " << percentile(lat, 99.0)
+        << ", \"max\": " << (lat.empty() ? 0.0 : lat.back())
+        << ", \"mean\": " << (lat.empty() ? 0.0 : sum / static_cast<double>(lat.size()))
+        << "}}";
+}
+
+void write_json(std::ostream& out, const std::string& corpus, int iterations, const std::vector<BenchShader>& shaders,
+                const std::vector<RunResult>& runs) {
+    out << "{\n  \"shaderpipe_version\": \"" << SHADERPIPE_VERSION << "\",\n"
+        << "  \"config\": {\"corpus\": \"" << json_escape(corpus) << "\", \"iterations\": " << iterations << "},\n"
+        << "  \"shaders\": [\n";
+    for (size_t i = 0; i < shaders.size(); ++i) {
+        const auto& s = shaders[i];
+        out << "    {\"name\": \"" << json_escape(s.name) << "\", \"stage\": \"" << s.stageName
+            << "\", \"source_bytes\": " << s.source.size() << ", \"spirv_words\": " << s.spirv.size()
+            << ", \"single_p50_us\": {";
+        bool first = true;
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            if (!s.errors[phase].empty())
+                continue;
+            out << (first ? "" : ", ") << "\"" << PhaseNames[phase] << "\": " << s.singleP50[phase];
+            first = false;
+        }
+        out << "}, \"skipped\": {";
+        first = true;
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            if (s.errors[phase].empty())
+                continue;
+            out << (first ? "" : ", ") << "\"" << PhaseNames[phase] << "\": \"" << json_escape(s.errors[phase]) << "\"";
+            first = false;
+        }
+        out << "}}" << (i + 1 < shaders.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"runs\": [\n";
+    for (size_t r = 0; r < runs.size(); ++r) {
+        const auto& run = runs[r];
+        out << "    {\"mode\": \"" << run.mode << "\", \"threads\": " << run.threads << ", \"phases\": {\n";
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            out << "      \"" << PhaseNames[phase] << "\": ";
+            write_phase(out, run.phases[phase]);
+            out << (phase + 1 < PHASE_COUNT ? ",\n" : "\n");
+        }
+        out << "    }}" << (r + 1 < runs.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void print_summary(const std::vector<RunResult>& runs) {
+    for (const auto& run : runs) {
+        for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+            const auto& r = run.phases[phase];
+            const double wallSec = r.wallMs / 1000.0;
+            std::fprintf(stderr, "%-9s %3u thread(s)  %-14s %7zu ops  %10.1f ops/s  p50 %9.1f us  p99 %9.1f us\n",
+                         run.mode.c_str(), run.threads, PhaseNames[phase], r.latenciesUs.size(),
+                         wallSec > 0.0 ? static_cast<double>(r.latenciesUs.size()) / wallSec : 0.0,
+                         percentile(r.latenciesUs, 50.0), percentile(r.latenciesUs, 99.0));
+        }
+    }
+}
+}
+
+int main(int argc, char** argv) {
+    std::string corpus = SHADERPIPE_BENCH_CORPUS;
+    std::string outPath;
+    int iterations = 10;
+    uint32_t threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--corpus" && hasValue)
+            corpus = argv[++i];
+        else if (arg == "--iterations" && hasValue)
+            iterations = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue)
+            threads = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        else if (arg == "--out" && hasValue)
+            outPath = argv[++i];
+        else {
+            std::cerr << "usage: shaderpipe_bench [--corpus <dir>] [--iterations <n>] [--threads <n>] [--out <file.json>]\n";
+            return 2;
+        }
+    }
+
+    try {
+        auto shaders = load_corpus(corpus);
+        warm_up(shaders);
+
+        std::vector<RunResult> runs;
+        runs.push_back(run_single(shaders, iterations));
+        ThreadPool pool(threads);
+        runs.push_back(run_parallel(shaders, iterations, pool));
+
+        for (auto& run : runs) {
+            for (auto& phase : run.phases)
+                std::sort(phase.latenciesUs.begin(), phase.latenciesUs.end());
+        }
+        print_summary(runs);
+
+        if (outPath.empty()) {
+            write_json(std::cout, corpus, iterations, shaders, runs);
+        } else {
+            std::ofstream out(outPath, std::ios::trunc);
+            if (!out) {
+                std::cerr << "Could not open " << outPath << "\n";
+                return 1;
+            }
+            write_json(out, corpus, iterations, shaders, runs);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Benchmark failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
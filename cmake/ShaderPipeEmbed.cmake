@@ -0,0 +1,91 @@
+# File: ShaderPipeEmbed
+# Project: shader-pipe
+# Author: Collin Longoria
+# Created on: 10/17/2026
+#
+# Copyright (c) 2025 Collin Longoria
+#
+# This software is released under the MIT License.
+# https://opensource.org/licenses/MIT
+
+# Compiles shaders at build time into headers of constexpr SPIR-V and reflection (see include/shader_embedded.hpp),
+# so a shipped build needs neither glslang nor the shader sources at runtime.
+#
+# shaderpipe_embed_shaders(<target>
+#     SHADERS <file>...
+#     [NAMESPACE <name>]                    C++ namespace of the generated symbols
+#     [OUTPUT_DIR <dir>]                    defaults to ${CMAKE_CURRENT_BINARY_DIR}/shaderpipe_embedded/<target>
+#     [TARGET_VERSION <1.0..1.4>]           Vulkan version, defaults to 1.3
+#     [OPTIMIZE NONE | PERFORMANCE | SIZE]
+#     [ACTIVE_ONLY]                         only reflect what the entry points use
+#     [INCLUDE_DIRS <dir>...]
+#     [DEFINES <name>[=<value>]...])
+#
+# Every shader becomes <file name>.hpp in OUTPUT_DIR, which is added to the target's include path, declaring
+# shaderpipe::EmbeddedShader <file name with '.' as '_'>. Headers are regenerated only when the shader or one of
+# the files it includes changes, shaderpipe_embed writes a depfile for that.
+
+function(shaderpipe_embed_shaders target)
+    cmake_parse_arguments(EMBED "ACTIVE_ONLY" "NAMESPACE;OUTPUT_DIR;TARGET_VERSION;OPTIMIZE" "SHADERS;INCLUDE_DIRS;DEFINES" ${ARGN})
+
+    if(NOT TARGET shaderpipe_embed)
+        message(FATAL_ERROR "shaderpipe_embed_shaders needs the shaderpipe_embed target, add shader-pipe with add_subdirectory first.")
+    endif()
+    if(NOT EMBED_SHADERS)
+        message(FATAL_ERROR "shaderpipe_embed_shaders(${target}) lists no SHADERS.")
+    endif()
+    if(NOT EMBED_OUTPUT_DIR)
+        set(EMBED_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/shaderpipe_embedded/${target}")
+    endif()
+
+    set(args)
+    if(EMBED_NAMESPACE)
+        list(APPEND args --namespace ${EMBED_NAMESPACE})
+    endif()
+    if(EMBED_TARGET_VERSION)
+        list(APPEND args --target ${EMBED_TARGET_VERSION})
+    endif()
+    if(EMBED_OPTIMIZE STREQUAL "PERFORMANCE")
+        list(APPEND args -O)
+    elseif(EMBED_OPTIMIZE STREQUAL "SIZE")
+        list(APPEND args -Os)
+    elseif(EMBED_OPTIMIZE AND NOT EMBED_OPTIMIZE STREQUAL "NONE")
+        message(FATAL_ERROR "shaderpipe_embed_shaders: unknown OPTIMIZE ${EMBED_OPTIMIZE}.")
+    endif()
+    if(EMBED_ACTIVE_ONLY)
+        list(APPEND args --active-only)
+    endif()
+    foreach(dir IN LISTS EMBED_INCLUDE_DIRS)
+        get_filename_component(dir "${dir}" ABSOLUTE)
+        list(APPEND args -I "${dir}")
+    endforeach()
+    foreach(define IN LISTS EMBED_DEFINES)
+        list(APPEND args -D "${define}")
+    endforeach()
+
+    file(MAKE_DIRECTORY "${EMBED_OUTPUT_DIR}")
+
+    set(headers)
+    foreach(shader IN LISTS EMBED_SHADERS)
+        get_filename_component(source "${shader}" ABSOLUTE)
+        get_filename_component(name "${shader}" NAME)
+        set(header "${EMBED_OUTPUT_DIR}/${name}.hpp")
+
+        add_custom_command(
+                OUTPUT "${header}"
+                COMMAND shaderpipe_embed "${source}" -o "${header}" --depfile "${header}.d" ${args}
+                DEPENDS "${source}" shaderpipe_embed
+                DEPFILE "${header}.d"
+                COMMENT "Embedding shader ${name}"
+                VERBATIM
+        )
+        list(APPEND headers "${header}")
+    endforeach()
+
+    # The headers only need shader_embedded.hpp and the Vulkan headers: shaderpipe's include path, nothing to link.
+    target_sources(${target} PRIVATE ${headers})
+    target_include_directories(${target} PRIVATE
+            "${EMBED_OUTPUT_DIR}"
+            $<TARGET_PROPERTY:shaderpipe,INTERFACE_INCLUDE_DIRECTORIES>
+    )
+endfunction()
@@ -0,0 +1,92 @@
+/*
+* File: shader_async
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_ASYNC_HPP
+#define SHADER_PIPE_SHADER_ASYNC_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_compiler.hpp"
+
+#include <future>
+#include <memory>
+#include <optional>
+
+namespace shaderpipe {
+
+// Higher runs first. Compiles of equal priority run in submission order.
+enum class CompilePriority : int32_t {
+    BACKGROUND = -100,
+    NORMAL     = 0,
+    VISIBLE    = 100,
+    CRITICAL   = 200,
+};
+
+struct SHADERPIPE_API AsyncCompilerOptions {
+    uint32_t threadCount = 0;  // 0 => hardware_concurrency() - 1, leaving a core for the thread that submits
+    size_t maxQueued = 256;    // compiles waiting to start; compile_async blocks beyond this
+};
+
+// Handle to one queued compile. Copies refer to the same compile.
+class SHADERPIPE_API CompileHandle {
+public:
+    CompileHandle() = default;
+
+    bool valid() const { return state != nullptr; }
+
+    // The result, or rethrows the compile error. A cancelled compile throws CompileCancelled.
+    const CompiledShader& get() const;
+    void wait() const;
+    bool ready() const;
+
+    // Honored right away while the compile is still queued, otherwise at the next phase boundary.
+    void cancel() const;
+    bool cancelled() const;
+
+    // Moves a queued compile up or down the queue. No effect once it started.
+    void set_priority(CompilePriority priority) const;
+
+private:
+    friend class AsyncCompiler;
+    struct State;
+    explicit CompileHandle(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+    std::shared_ptr<State> state;
+};
+
+// Priority scheduled background compiles on top of a Compiler.
+// Runs on its own threads rather than the shared ThreadPool: the queue needs priorities and has to stay bounded.
+class SHADERPIPE_API AsyncCompiler {
+public:
+    explicit AsyncCompiler(const Compiler& compiler, AsyncCompilerOptions options = {});
+    ~AsyncCompiler(); // cancels everything still queued, waits for running compiles to hit a phase boundary
+
+    AsyncCompiler(const AsyncCompiler&) = delete;
+    AsyncCompiler& operator=(const AsyncCompiler&) = delete;
+
+    // Blocks while the queue is full, which is what keeps a burst of requests from piling up without bound.
+    CompileHandle compile_async(std::string source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                CompileOptions options = {}, CompilePriority priority = CompilePriority::NORMAL);
+
+    // Same, but gives up instead of blocking when the queue is full. For threads that must never stall.
+    std::optional<CompileHandle> try_compile_async(std::string source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                   CompileOptions options = {}, CompilePriority priority = CompilePriority::NORMAL);
+
+    size_t queued() const;
+
+private:
+    friend class CompileHandle;
+    struct Impl;
+    std::shared_ptr<Impl> impl;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_ASYNC_HPP
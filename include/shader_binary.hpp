@@ -0,0 +1,236 @@
+/*
+* File: shader_binary
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_BINARY_HPP
+#define SHADER_PIPE_SHADER_BINARY_HPP
+
+#include "shader_pipe.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+namespace shaderpipe {
+
+// Flat, versioned on-disk form of a CompiledShader: SPIR-V, reflection tables and one interned string table.
+// Every field is a little endian uint32 and every table is 4 byte aligned, so a blob can be used straight out of
+// a memory mapping through the views below, without parsing or allocating.
+namespace binary {
+    inline constexpr uint32_t Magic   = 0x46425053; // "SPBF"
+    inline constexpr uint32_t Version = 5;          // bump whenever a record below changes
+
+    struct Section {
+        uint32_t offset; // bytes from the start of the blob
+        uint32_t count;  // records (bytes for the string table)
+    };
+
+    // Points into the string table, the string is followed by a NUL.
+    struct String {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t size; // whole blob, in bytes
+        Section spirv;
+        Section descriptorBindings;
+        Section pushConstants;
+        Section inputs;
+        Section outputs;
+        Section specConstants;
+        Section unusedDescriptorBindings;
+        Section strings;
+    };
+
+    struct DescriptorBinding {
+        uint32_t set;
+        uint32_t binding;
+        String name;
+        uint32_t type;
+        uint32_t count;
+        uint32_t stageFlags;
+    };
+
+    struct PushConstant {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t stageFlags;
+    };
+
+    struct Attribute {
+        uint32_t location;
+        String name;
+        uint32_t vecSize;
+        uint32_t bitWidth;
+        uint32_t baseType;
+        uint32_t columns;
+        uint32_t arraySize;
+    };
+
+    struct SpecConstant {
+        uint32_t constantId;
+        String name;
+        uint32_t type;
+        uint32_t bitWidth;
+        uint32_t defaultLow;  // split so every record stays 4 byte aligned
+        uint32_t defaultHigh;
+    };
+}
+
+class SHADERPIPE_API DescriptorBindingView {
+public:
+    DescriptorBindingView(const binary::DescriptorBinding* record, const char* strings) : record(record), strings(strings) {}
+
+    uint32_t           set        () const { return record->set; }
+    uint32_t           binding    () const { return record->binding; }
+    std::string_view   name       () const { return { strings + record->name.offset, record->name.length }; }
+    VkDescriptorType   type       () const { return static_cast<VkDescriptorType>(record->type); }
+    uint32_t           count      () const { return record->count; }
+    VkShaderStageFlags stageFlags () const { return record->stageFlags; }
+
+    DescriptorBindingInfo to_info() const;
+
+private:
+    const binary::DescriptorBinding* record;
+    const char* strings;
+};
+
+class SHADERPIPE_API PushConstantView {
+public:
+    PushConstantView(const binary::PushConstant* record, const char*) : record(record) {}
+
+    uint32_t           offset     () const { return record->offset; }
+    uint32_t           size       () const { return record->size; }
+    VkShaderStageFlags stageFlags () const { return record->stageFlags; }
+
+    PushConstantInfo to_info() const;
+
+private:
+    const binary::PushConstant* record;
+};
+
+class SHADERPIPE_API AttributeView {
+public:
+    AttributeView(const binary::Attribute* record, const char* strings) : record(record), strings(strings) {}
+
+    uint32_t         location () const { return record->location; }
+    std::string_view name     () const { return { strings + record->name.offset, record->name.length }; }
+    uint32_t         vecSize   () const { return record->vecSize; }
+    uint32_t         bitWidth  () const { return record->bitWidth; }
+    ScalarType       baseType  () const { return static_cast<ScalarType>(record->baseType); }
+    uint32_t         columns   () const { return record->columns; }
+    uint32_t         arraySize () const { return record->arraySize; }
+
+    InputAttributeInfo to_info() const;
+
+private:
+    const binary::Attribute* record;
+    const char* strings;
+};
+
+class SHADERPIPE_API SpecConstantView {
+public:
+    SpecConstantView(const binary::SpecConstant* record, const char* strings) : record(record), strings(strings) {}
+
+    uint32_t         constantId   () const { return record->constantId; }
+    std::string_view name         () const { return { strings + record->name.offset, record->name.length }; }
+    ScalarType       type         () const { return static_cast<ScalarType>(record->type); }
+    uint32_t         bitWidth     () const { return record->bitWidth; }
+    uint64_t         defaultValue () const { return (static_cast<uint64_t>(record->defaultHigh) << 32) | record->defaultLow; }
+
+    SpecConstantInfo to_info() const;
+
+private:
+    const binary::SpecConstant* record;
+    const char* strings;
+};
+
+// A table of records handed out as views.
+template<typename Record, typename View>
+class BinaryTable {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = View;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = View;
+
+        iterator() = default;
+        iterator(const Record* record, const char* strings) : record(record), strings(strings) {}
+
+        View operator*() const { return View(record, strings); }
+        iterator& operator++() { ++record; return *this; }
+        iterator operator++(int) { auto old = *this; ++record; return old; }
+        bool operator==(const iterator& other) const { return record == other.record; }
+
+    private:
+        const Record* record = nullptr;
+        const char* strings = nullptr;
+    };
+
+    BinaryTable() = default;
+    BinaryTable(const Record* records, size_t count, const char* strings) : records(records), length(count), strings(strings) {}
+
+    size_t size  () const { return length; }
+    bool   empty () const { return length == 0; }
+
+    View operator[](size_t i) const { return View(records + i, strings); }
+
+    iterator begin () const { return { records, strings }; }
+    iterator end   () const { return { records + length, strings }; }
+
+private:
+    const Record* records = nullptr;
+    size_t length = 0;
+    const char* strings = nullptr;
+};
+
+// Read only view of a blob produced by write_shader_binary. Does not own the bytes, they have to outlive the view.
+class SHADERPIPE_API ShaderBinaryView {
+public:
+    // Checks the header and that every table and string lies inside data (4 byte aligned, as a mapping is).
+    // Returns nothing for a malformed, truncated or differently versioned blob.
+    static std::optional<ShaderBinaryView> from_bytes(std::span<const uint8_t> data);
+
+    std::span<const uint32_t> spirv() const;
+
+    BinaryTable<binary::DescriptorBinding, DescriptorBindingView> descriptor_bindings () const;
+    BinaryTable<binary::PushConstant, PushConstantView>           push_constants      () const;
+    BinaryTable<binary::Attribute, AttributeView>                 inputs              () const;
+    BinaryTable<binary::Attribute, AttributeView>                 outputs             () const;
+    BinaryTable<binary::SpecConstant, SpecConstantView>           spec_constants      () const;
+    BinaryTable<binary::DescriptorBinding, DescriptorBindingView> unused_descriptor_bindings () const;
+
+    // Owning copy, for callers that want the plain structs.
+    CompiledShader to_compiled_shader() const;
+
+private:
+    explicit ShaderBinaryView(const uint8_t* base) : base(base) {}
+
+    const binary::Header& header() const { return *reinterpret_cast<const binary::Header*>(base); }
+    const char* strings() const { return reinterpret_cast<const char*>(base + header().strings.offset); }
+
+    template<typename Record>
+    const Record* records(const binary::Section& section) const { return reinterpret_cast<const Record*>(base + section.offset); }
+
+    const uint8_t* base = nullptr;
+};
+
+// Names are interned, a name that shows up in several tables is stored once.
+SHADERPIPE_API std::vector<uint8_t> write_shader_binary(const CompiledShader& shader);
+}
+
+#endif //SHADER_PIPE_SHADER_BINARY_HPP
@@ -0,0 +1,69 @@
+/*
+* File: shader_canonical
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_CANONICAL_HPP
+#define SHADER_PIPE_SHADER_CANONICAL_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_hash.hpp"
+
+#include <memory>
+
+namespace shaderpipe {
+
+// Rewrites a module into a form that only depends on what it does: debug and non-semantic instructions are
+// stripped, functions are ordered by the call graph from the entry points, global types / constants / variables
+// by first use, ids renumbered in that order, and order independent instructions (capabilities, decorations,
+// entry point interfaces, ...) sorted. Two modules that differ only in names, id numbering or the order
+// includes pulled their functions in come out word for word identical. The result is a valid module.
+// Throws std::runtime_error on a malformed module.
+SHADERPIPE_API std::vector<uint32_t> canonicalize_spirv (std::span<const uint32_t> source);
+
+// Hash of the reflection with every table sorted and names left out, which are debug info too.
+SHADERPIPE_API ShaderHash hash_reflection (const ShaderReflection& reflection);
+
+// canonicalize_spirv + hash_reflection, equal for shaders that can share one VkShaderModule and pipeline.
+SHADERPIPE_API ShaderHash canonical_shader_hash (const CompiledShader& shader);
+
+struct SHADERPIPE_API RegisteredModule {
+    ShaderHash hash;                              // canonical_shader_hash
+    std::shared_ptr<const CompiledShader> shader; // the one instance every equivalent shader shares
+    bool inserted;                                // false when an equivalent shader was registered before
+};
+
+// Collapses equivalent shaders onto one shared, immutable instance, so every material that compiles to the same
+// thing ends up with one VkShaderModule and one set of pipelines. The first shader registered for a hash is the
+// one kept, with its debug info and names. Thread safe.
+class SHADERPIPE_API ModuleRegistry {
+public:
+    ModuleRegistry();
+    ~ModuleRegistry();
+
+    ModuleRegistry(const ModuleRegistry&) = delete;
+    ModuleRegistry& operator=(const ModuleRegistry&) = delete;
+
+    RegisteredModule add(CompiledShader shader);
+
+    std::shared_ptr<const CompiledShader> find   (const ShaderHash& hash) const;
+    bool                                  remove (const ShaderHash& hash);
+    void                                  clear  ();
+
+    size_t   size       () const; // unique shaders
+    uint64_t duplicates () const; // add calls that were collapsed onto an existing shader
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_CANONICAL_HPP
@@ -0,0 +1,129 @@
+/*
+* File: shader_compiler
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_COMPILER_HPP
+#define SHADER_PIPE_SHADER_COMPILER_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_hash.hpp"
+#include "shader_optimizer.hpp"
+#include "shader_result.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+namespace shaderpipe {
+class ThreadPool;
+class DiskCache;
+
+struct SHADERPIPE_API CompilerSettings {
+    // Optional persistent cache, shared between every compile that goes through this Compiler.
+    std::shared_ptr<DiskCache> diskCache;
+};
+
+// #define name value, injected ahead of the source. An empty value defines the name without one.
+struct SHADERPIPE_API ShaderDefine {
+    std::string name;
+    std::string value;
+};
+
+struct SHADERPIPE_API CompileOptions {
+    // Runs after GlslangToSpv, reflection always describes the optimized module.
+    OptimizationOptions optimization;
+
+    // #include support. "" includes resolve next to the including file first (sourcePath for the top level file),
+    // then through includeDirectories in order; <> includes only use includeDirectories.
+    std::filesystem::path sourcePath;
+    std::vector<std::filesystem::path> includeDirectories;
+
+    // Applied in order, through the glslang preamble, so line numbers in error messages still match the source.
+    std::vector<ShaderDefine> defines;
+
+    // How glsl_to_spirv_with_reflection reflects the result.
+    ReflectionOptions reflection;
+
+    // Checked before the compile starts and between phases, setting it makes the call throw CompileCancelled
+    // (StatusCode::CANCELLED from try_glsl_to_spirv_with_reflection).
+    // Not part of the cache key.
+    std::shared_ptr<const std::atomic<bool>> cancelFlag;
+
+    bool includes_enabled() const { return !sourcePath.empty() || !includeDirectories.empty(); }
+};
+
+class SHADERPIPE_API CompileCancelled : public std::runtime_error {
+public:
+    CompileCancelled() : std::runtime_error("Shader compile was cancelled.") {}
+};
+
+// Feeds every option that can change the compiled output into h. Used for cache keys.
+SHADERPIPE_API void hash_compile_options(Hasher& h, const CompileOptions& options);
+
+struct SHADERPIPE_API CompileJob {
+    std::string_view source; // must stay alive until the batch returns, nothing is copied
+    ShaderStage stage;
+    VKVersion targetVulkanVersion;
+    CompileOptions options{};
+};
+
+struct SHADERPIPE_API BatchResult {
+    CompiledShader shader;
+    bool success = false;
+    std::string error; // glslang info log when success == false
+};
+
+// Long lived compiler context.
+// glslang is initialized once for the lifetime of the process (the first Compiler to be created does it),
+// so the built-in symbol tables glslang builds per stage / version stay warm between compiles instead of
+// being torn down and rebuilt on every call.
+// Every TShader / TProgram is local to the call, so a single Compiler can be used from many threads at once.
+class SHADERPIPE_API Compiler {
+public:
+    explicit Compiler(CompilerSettings settings = {});
+    ~Compiler();
+
+    Compiler(const Compiler&) = delete;
+    Compiler& operator=(const Compiler&) = delete;
+
+    // Runs only the glslang preprocessor, the output is what the cache key is computed from.
+    // includedFiles receives every header that was pulled in (transitively), canonical paths.
+    std::string           preprocess                    (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                         const CompileOptions& options = {}, std::vector<std::string>* includedFiles = nullptr) const;
+    ShaderHash            cache_key                     (std::string_view preprocessedSource, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options = {}) const;
+
+    std::vector<uint32_t> glsl_to_spirv                 (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options = {}) const;
+    CompiledShader        glsl_to_spirv_with_reflection (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options = {}) const;
+
+    // Same compile, but errors in the shader come back in the result and diagnostics instead of as exceptions, and
+    // glslang's failures never unwind. Cancellation is StatusCode::CANCELLED.
+    Result<CompiledShader> try_glsl_to_spirv_with_reflection (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                              DiagnosticBuffer& diagnostics, const CompileOptions& options = {}) const noexcept;
+
+    // Compiles + reflects every job across the pool. Results come back in input order, a failing job only
+    // fills in its own error slot and never aborts the rest of the batch.
+    std::vector<BatchResult> compile_batch(std::span<const CompileJob> jobs, ThreadPool& pool) const;
+    std::vector<BatchResult> compile_batch(std::span<const CompileJob> jobs) const; // default_thread_pool()
+
+    const CompilerSettings& get_settings() const { return settings; }
+
+private:
+    CompilerSettings settings;
+};
+
+// Process wide compiler used by the free functions in shader_pipe.hpp.
+SHADERPIPE_API Compiler& default_compiler();
+}
+
+#endif //SHADER_PIPE_SHADER_COMPILER_HPP
@@ -0,0 +1,88 @@
+/*
+* File: shader_daemon
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_DAEMON_HPP
+#define SHADER_PIPE_SHADER_DAEMON_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_compiler.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace shaderpipe {
+
+// $SHADERPIPE_SOCKET, otherwise shaderpipe-<uid>.sock in $XDG_RUNTIME_DIR or the temp directory.
+SHADERPIPE_API std::filesystem::path default_daemon_socket_path();
+
+struct SHADERPIPE_API DaemonOptions {
+    std::filesystem::path socketPath;      // empty => default_daemon_socket_path()
+    uint32_t threadCount = 0;              // compile threads, 0 => hardware_concurrency()
+    uint64_t cacheBytes = 256ull * 1024 * 1024;
+};
+
+// Keeps a warm compiler behind a Unix domain socket, so build systems that spawn one process per shader skip
+// library loading and glslang start up on every file. Requests from every client share one thread pool and one
+// in-memory cache. POSIX only, start() throws elsewhere.
+class SHADERPIPE_API ShaderDaemon {
+public:
+    explicit ShaderDaemon(const Compiler& compiler, DaemonOptions options = {});
+    ~ShaderDaemon(); // stop()
+
+    ShaderDaemon(const ShaderDaemon&) = delete;
+    ShaderDaemon& operator=(const ShaderDaemon&) = delete;
+
+    // Binds the socket and serves on a background thread. Throws if the socket can not be bound or another
+    // daemon is already answering on it; a stale socket file left by a crashed daemon is replaced.
+    void start();
+    void stop(); // removes the socket file, compiles in flight still finish
+
+    const std::filesystem::path& socket_path() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+// Sends compiles to a running ShaderDaemon. Whenever the daemon can not be reached (not started, crashed, hung
+// for longer than a minute, protocol mismatch) the request is compiled in-process with the fallback compiler instead, so callers never
+// have to care whether one is running. Compile errors reported by the daemon are rethrown as runtime_error.
+// Relative paths in CompileOptions are made absolute before they are sent, the daemon has its own working directory.
+class SHADERPIPE_API DaemonClient {
+public:
+    explicit DaemonClient(std::filesystem::path socketPath = {}, const Compiler& fallback = default_compiler());
+    ~DaemonClient();
+
+    DaemonClient(const DaemonClient&) = delete;
+    DaemonClient& operator=(const DaemonClient&) = delete;
+
+    // Connects now rather than on the first request. Returns whether a daemon answered.
+    bool connect();
+    bool connected() const;
+
+    CompiledShader   glsl_to_spirv_with_reflection (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options = {});
+    ShaderReflection reflect_spirv                 (std::span<const uint32_t> source);
+
+private:
+    std::optional<CompiledShader> request(std::vector<uint8_t> payload); // nullopt => fall back
+
+    std::filesystem::path socketPath;
+    const Compiler& fallback;
+    mutable std::mutex mutex; // one request at a time on the connection
+    int fd = -1;
+    uint32_t nextRequestId = 1;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_DAEMON_HPP
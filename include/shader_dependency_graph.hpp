@@ -0,0 +1,58 @@
+/*
+* File: shader_dependency_graph
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_DEPENDENCY_GRAPH_HPP
+#define SHADER_PIPE_SHADER_DEPENDENCY_GRAPH_HPP
+
+#include "shader_pipe.hpp"
+
+#include <filesystem>
+#include <memory>
+
+namespace shaderpipe {
+
+// The form every path is stored in, so a header reached through two different relative paths is one node.
+SHADERPIPE_API std::string canonical_shader_path(const std::filesystem::path& path);
+
+// Shader file -> every header it includes (transitively), plus the reverse index.
+// Thread safe. Can be saved next to the build output so the next session starts with a warm graph.
+class SHADERPIPE_API DependencyGraph {
+public:
+    DependencyGraph();
+    ~DependencyGraph();
+
+    DependencyGraph(const DependencyGraph&) = delete;
+    DependencyGraph& operator=(const DependencyGraph&) = delete;
+
+    // Replaces whatever was recorded for shader before.
+    void set_dependencies (const std::string& shader, const std::vector<std::string>& includes);
+    void remove           (const std::string& shader);
+    void clear            ();
+
+    std::vector<std::string> dependencies_of  (const std::string& shader) const;
+
+    // Every shader that has to be rebuilt when file changes: file itself if it is a shader, plus each shader including it.
+    std::vector<std::string> affected_shaders (const std::string& file) const;
+
+    std::vector<std::string> shaders () const;
+    std::vector<std::string> files   () const; // shaders and headers
+
+    bool save (const std::filesystem::path& path) const;
+    bool load (const std::filesystem::path& path);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_DEPENDENCY_GRAPH_HPP
@@ -0,0 +1,55 @@
+/*
+* File: shader_disk_cache
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_DISK_CACHE_HPP
+#define SHADER_PIPE_SHADER_DISK_CACHE_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_hash.hpp"
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+
+namespace shaderpipe {
+
+struct SHADERPIPE_API DiskCacheOptions {
+    std::filesystem::path directory;
+    uint64_t maxSizeBytes = 512ull * 1024 * 1024;
+};
+
+// Persistent content addressed cache of compiled shaders (SPIR-V + reflection).
+// Entries are read through a memory mapping and written to a temp file that is then renamed into place,
+// so any number of threads / build processes can share one directory. Once the directory grows past
+// maxSizeBytes the least recently used entries (by file modification time, refreshed on every hit) are removed.
+class SHADERPIPE_API DiskCache {
+public:
+    explicit DiskCache(DiskCacheOptions options);
+
+    std::optional<CompiledShader> load  (const ShaderHash& key) const;
+    void                          store (const ShaderHash& key, const CompiledShader& shader);
+
+    // Evicts least recently used entries until the cache fits in maxSizeBytes again. Temp files a crashed or killed
+    // writer left behind count against the limit and are removed once they are an hour old.
+    void trim();
+
+    const DiskCacheOptions& options() const { return opts; }
+
+private:
+    std::filesystem::path entry_path(const ShaderHash& key) const;
+
+    DiskCacheOptions opts;
+    std::atomic<uint64_t> approxSize{0}; // only this process' view, trim() rescans the directory
+};
+}
+
+#endif //SHADER_PIPE_SHADER_DISK_CACHE_HPP
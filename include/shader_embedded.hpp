@@ -0,0 +1,96 @@
+/*
+* File: shader_embedded
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_EMBEDDED_HPP
+#define SHADER_PIPE_SHADER_EMBEDDED_HPP
+
+#include "shader_pipe.hpp"
+
+#include <string_view>
+
+// Shaders compiled at build time by shaderpipe_embed_shaders (cmake/ShaderPipeEmbed.cmake). The generated headers
+// only hold constexpr data of the types below, everything here is header only so a program that embeds all of
+// its shaders does not have to link shaderpipe at all.
+
+namespace shaderpipe {
+
+struct EmbeddedDescriptorBinding {
+    uint32_t set;
+    uint32_t binding;
+    std::string_view name;
+    VkDescriptorType type;
+    uint32_t count;
+    VkShaderStageFlags stageFlags;
+};
+
+struct EmbeddedPushConstant {
+    uint32_t offset;
+    uint32_t size;
+    VkShaderStageFlags stageFlags;
+};
+
+struct EmbeddedAttribute {
+    uint32_t location;
+    std::string_view name;
+    uint32_t vecSize;
+    uint32_t bitWidth;
+    ScalarType baseType;
+    uint32_t columns;
+    uint32_t arraySize;
+};
+
+struct EmbeddedSpecConstant {
+    uint32_t constantId;
+    std::string_view name;
+    ScalarType type;
+    uint32_t bitWidth;
+    uint64_t defaultValue;
+};
+
+// Same tables as ShaderReflection, pointing into read-only data.
+struct EmbeddedShader {
+    std::string_view name; // the source file name
+    ShaderStage stage;
+    std::span<const uint32_t> spirv;
+    std::span<const EmbeddedDescriptorBinding> descriptorBindings;
+    std::span<const EmbeddedPushConstant> pushConstants;
+    std::span<const EmbeddedAttribute> inputs;
+    std::span<const EmbeddedAttribute> outputs;
+    std::span<const EmbeddedSpecConstant> specConstants;
+
+    constexpr VkShaderModuleCreateInfo module_create_info() const {
+        VkShaderModuleCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        info.codeSize = spirv.size_bytes();
+        info.pCode = spirv.data();
+        return info;
+    }
+
+    // Copies everything into the runtime types, for code written against ShaderReflection.
+    ShaderReflection to_reflection() const {
+        ShaderReflection out;
+        for (const auto& b : descriptorBindings)
+            out.descriptorBindings.push_back({ b.set, b.binding, std::string(b.name), b.type, b.count, b.stageFlags });
+        for (const auto& p : pushConstants)
+            out.pushConstants.push_back({ p.offset, p.size, p.stageFlags });
+        for (const auto& a : inputs)
+            out.inputs.push_back({ a.location, std::string(a.name), a.vecSize, a.bitWidth, a.baseType, a.columns, a.arraySize });
+        for (const auto& a : outputs)
+            out.outputs.push_back({ a.location, std::string(a.name), a.vecSize, a.bitWidth, a.baseType, a.columns, a.arraySize });
+        for (const auto& s : specConstants)
+            out.specConstants.push_back({ s.constantId, std::string(s.name), s.type, s.bitWidth, s.defaultValue });
+        return out;
+    }
+};
+}
+
+#endif //SHADER_PIPE_SHADER_EMBEDDED_HPP
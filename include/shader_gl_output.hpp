@@ -0,0 +1,71 @@
+/*
+* File: shader_gl_output
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_GL_OUTPUT_HPP
+#define SHADER_PIPE_SHADER_GL_OUTPUT_HPP
+
+#include "shader_compiler.hpp"
+
+namespace shaderpipe {
+
+enum class GlPrecision : uint32_t {
+    LOW,
+    MEDIUM,
+    HIGH,
+};
+
+// GLSL for GL / GLES / WebGL drivers, which get no optimizing front end of their own worth relying on: the SPIR-V
+// goes through spirv-opt before SPIRV-Cross turns it back into GLSL.
+struct SHADERPIPE_API GlOutputOptions {
+    GlVersion version = GlVersion::GL_310;
+
+    // spirv-opt's performance passes. glslang's output is full of loads and stores through temporaries that
+    // mobile drivers often do not clean up.
+    bool optimize = true;
+
+    // ES only. Vertex shaders keep the highp default the specification gives them.
+    GlPrecision fragmentFloatPrecision = GlPrecision::MEDIUM;
+    GlPrecision fragmentIntPrecision = GlPrecision::HIGH;
+
+    // Marks float arithmetic that does not need 32 bits as relaxed (spirv-opt --relax-float-ops), which comes out
+    // as mediump in ES and lets mobile GPUs run it at half precision. Changes results, off by default.
+    bool relaxPrecision = false;
+
+    // Uniform blocks become plain uniform vec4 arrays, for drivers where uniform buffers are slow or missing.
+    // Every member of a flattened block has to share one base type (all float, all int, ...), otherwise this throws.
+    bool flattenUniformBuffers = false;
+};
+
+struct SHADERPIPE_API GlOutputStats {
+    size_t inputWords = 0;            // the SPIR-V going in, straight from glslang for glsl_to_gl
+    size_t inputInstructions = 0;
+    size_t optimizedWords = 0;        // after the passes, what SPIRV-Cross generated code from
+    size_t optimizedInstructions = 0;
+    size_t glslBytes = 0;
+    size_t glslLines = 0;
+};
+
+struct SHADERPIPE_API GlOutput {
+    std::string glsl;
+    GlOutputStats stats;
+};
+
+SHADERPIPE_API GlOutput spirv_to_gl (std::span<const uint32_t> source, const GlOutputOptions& options = {});
+// Compiles for Vulkan 1.0 (SPIR-V 1.0) first, compileOptions.optimization is ignored in favor of options.optimize.
+SHADERPIPE_API GlOutput glsl_to_gl  (std::string_view source, ShaderStage stage, const GlOutputOptions& options = {},
+                                     const CompileOptions& compileOptions = {});
+
+// Instructions in a module, header not counted.
+SHADERPIPE_API size_t spirv_instruction_count (std::span<const uint32_t> source);
+}
+
+#endif //SHADER_PIPE_SHADER_GL_OUTPUT_HPP
@@ -0,0 +1,71 @@
+/*
+* File: shader_hash
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_HASH_HPP
+#define SHADER_PIPE_SHADER_HASH_HPP
+
+#include "shader_pipe.hpp"
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace shaderpipe {
+
+// 256 bit content hash (SHA-256). Used as the key for anything content addressed.
+struct SHADERPIPE_API ShaderHash {
+    std::array<uint8_t, 32> bytes{};
+
+    std::string to_hex() const;
+
+    bool operator==(const ShaderHash&) const = default;
+    auto operator<=>(const ShaderHash&) const = default;
+};
+
+// Streaming SHA-256.
+class SHADERPIPE_API Hasher {
+public:
+    Hasher();
+
+    void update(const void* data, size_t size);
+    void update(std::string_view str);
+
+    // Hashes the object representation, only use this for types without padding.
+    template<typename T>
+    void update_value(const T& value) { update(&value, sizeof(T)); }
+
+    ShaderHash finish();
+
+private:
+    void compress(const uint8_t* block);
+
+    uint32_t state[8];
+    uint64_t length = 0;
+    uint8_t buffer[64];
+    size_t bufferSize = 0;
+};
+}
+
+template<>
+struct std::hash<shaderpipe::ShaderHash> {
+    size_t operator()(const shaderpipe::ShaderHash& h) const noexcept {
+        // Already uniformly distributed, any slice of it will do.
+        size_t v;
+        std::memcpy(&v, h.bytes.data(), sizeof(v));
+        return v;
+    }
+};
+
+#endif //SHADER_PIPE_SHADER_HASH_HPP
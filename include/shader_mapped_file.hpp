@@ -0,0 +1,64 @@
+/*
+* File: shader_mapped_file
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_MAPPED_FILE_HPP
+#define SHADER_PIPE_SHADER_MAPPED_FILE_HPP
+
+#include "shader_pipe.hpp"
+
+#include <cstddef>
+#include <filesystem>
+
+namespace shaderpipe {
+
+// Read only memory mapping of a whole file. The views stay valid for as long as the MappedFile is alive.
+class SHADERPIPE_API MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Returns false (and leaves the mapping empty) if the file can not be opened or mapped.
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    bool is_open() const { return isOpen; }
+    const uint8_t* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // GLSL source straight out of the page cache.
+    std::string_view view() const { return { reinterpret_cast<const char*>(bytes), length }; }
+
+    // SPIR-V words. Mappings are page aligned, so this only comes back empty for a size that is not a multiple of 4.
+    std::span<const uint32_t> words() const;
+
+private:
+    const uint8_t* bytes = nullptr;
+    size_t length = 0;
+    bool isOpen = false;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// Zero copy counterpart to load_shader_file. Throws if the file can not be opened.
+// Only for files nobody rewrites while mapped (cache entries, packs): if a mapped file shrinks, reading past its
+// new end raises SIGBUS. Sources that are being edited go through load_shader_file.
+SHADERPIPE_API MappedFile map_shader_file(const std::string& filename);
+}
+
+#endif //SHADER_PIPE_SHADER_MAPPED_FILE_HPP
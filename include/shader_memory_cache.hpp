@@ -0,0 +1,55 @@
+/*
+* File: shader_memory_cache
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_MEMORY_CACHE_HPP
+#define SHADER_PIPE_SHADER_MEMORY_CACHE_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_compiler.hpp"
+
+#include <memory>
+
+namespace shaderpipe {
+
+struct SHADERPIPE_API CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+};
+
+// Opt in, memory bounded LRU cache in front of glsl_to_spirv_with_reflection and spirv_to_glsl.
+// Results are shared and immutable: a hit hands out another reference to the cached object,
+// nothing is recompiled or copied. Safe to use from any number of threads.
+class SHADERPIPE_API ShaderCache {
+public:
+    explicit ShaderCache(uint64_t maxBytes = 64ull * 1024 * 1024);
+    ~ShaderCache();
+
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+
+    std::shared_ptr<const CompiledShader> glsl_to_spirv_with_reflection (const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options = {});
+    std::shared_ptr<const CompiledShader> glsl_to_spirv_with_reflection (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options = {}); // default_compiler()
+    std::shared_ptr<const std::string>    spirv_to_glsl                 (std::span<const uint32_t> source, GlVersion version = GlVersion::GL_450);
+
+    CacheStats stats() const;
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_MEMORY_CACHE_HPP
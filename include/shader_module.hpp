@@ -0,0 +1,49 @@
+/*
+* File: shader_module
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_MODULE_HPP
+#define SHADER_PIPE_SHADER_MODULE_HPP
+
+#include "shader_pipe.hpp"
+
+#include <memory>
+
+namespace shaderpipe {
+
+// A SPIR-V module that is parsed exactly once.
+// reflect_spirv / spirv_to_glsl each re-parse the words they are handed, a ShaderModule keeps the parsed IR around
+// and serves reflection and any number of GLSL cross compiles from it. All const members are safe to call
+// from several threads at once.
+class SHADERPIPE_API ShaderModule {
+public:
+    explicit ShaderModule(std::vector<uint32_t> spirv);
+    explicit ShaderModule(CompiledShader shader); // reuses the reflection that came with it
+    ~ShaderModule();
+
+    ShaderModule(ShaderModule&&) noexcept;
+    ShaderModule& operator=(ShaderModule&&) noexcept;
+
+    const std::vector<uint32_t>& spirv() const;
+
+    // Computed on first use, then cached.
+    const ShaderReflection& reflection() const;
+    ShaderReflection        reflection(const ReflectionOptions& options) const; // not cached, still skips the parse
+
+    std::string to_glsl(GlVersion version = GlVersion::GL_450) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_MODULE_HPP
@@ -0,0 +1,69 @@
+/*
+* File: shader_optimizer
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_OPTIMIZER_HPP
+#define SHADER_PIPE_SHADER_OPTIMIZER_HPP
+
+#include "shader_pipe.hpp"
+
+#include <bit>
+
+namespace shaderpipe {
+
+enum class OptimizationLevel : uint32_t {
+    NONE,
+    PERFORMANCE, // spirv-opt -O
+    SIZE,        // spirv-opt -Os
+};
+
+struct SHADERPIPE_API OptimizationOptions {
+    OptimizationLevel level = OptimizationLevel::NONE;
+
+    // Extra spirv-opt passes, same spelling as the spirv-opt command line (e.g. "--eliminate-dead-code-aggressive").
+    // They run after the preset, or on their own with level == NONE.
+    std::vector<std::string> customPasses;
+
+    // Run spirv-val on the module before / after optimizing. Failures throw with the validator output.
+    bool validateInput = true;
+    bool validateOutput = true;
+
+    bool enabled() const { return level != OptimizationLevel::NONE || !customPasses.empty(); }
+};
+
+// A concrete value for one specialization constant, same bit layout as SpecConstantInfo::defaultValue: integers are
+// sign extended (INT) or zero extended (UINT) to 64 bits, so from_int(id, -1) equals the reflected default of an
+// `int x = -1` constant. specialize_spirv cuts the value down to the constant's own width.
+struct SHADERPIPE_API SpecConstantValue {
+    uint32_t constantId;
+    uint64_t bits;
+
+    static SpecConstantValue from_bool  (uint32_t id, bool v)     { return { id, v ? 1u : 0u }; }
+    static SpecConstantValue from_int   (uint32_t id, int64_t v)  { return { id, static_cast<uint64_t>(v) }; }
+    static SpecConstantValue from_uint  (uint32_t id, uint64_t v) { return { id, v }; }
+    static SpecConstantValue from_float (uint32_t id, float v)    { return { id, std::bit_cast<uint32_t>(v) }; }
+    static SpecConstantValue from_double(uint32_t id, double v)   { return { id, std::bit_cast<uint64_t>(v) }; }
+};
+
+SHADERPIPE_API std::vector<uint32_t> optimize_spirv (std::span<const uint32_t> source, VKVersion targetVulkanVersion, const OptimizationOptions& options);
+SHADERPIPE_API bool                  validate_spirv (std::span<const uint32_t> source, VKVersion targetVulkanVersion, std::string* log = nullptr);
+
+// Size only, never changes behavior: optionally strips debug and non-semantic instructions, then renumbers ids densely.
+SHADERPIPE_API std::vector<uint32_t> compact_spirv    (std::span<const uint32_t> source, bool stripDebugInfo, bool compactIds = true);
+
+// Bakes values into the module: every specialization constant becomes a plain constant (the ones not in values keep
+// their default), then constant expressions are folded and the branches they decide are removed before the driver
+// ever sees them. The reflection is recomputed, so arrays sized by a constant report their real descriptor count.
+// Throws if values names a constant id the module does not have.
+SHADERPIPE_API CompiledShader        specialize_spirv (std::span<const uint32_t> source, std::span<const SpecConstantValue> values, VKVersion targetVulkanVersion);
+}
+
+#endif //SHADER_PIPE_SHADER_OPTIMIZER_HPP
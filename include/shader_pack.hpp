@@ -0,0 +1,92 @@
+/*
+* File: shader_pack
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_PACK_HPP
+#define SHADER_PIPE_SHADER_PACK_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_hash.hpp"
+#include "shader_binary.hpp"
+#include "shader_mapped_file.hpp"
+
+#include <filesystem>
+#include <map>
+#include <optional>
+
+namespace shaderpipe {
+
+struct SHADERPIPE_API ShaderPackOptions {
+    // Drops OpName / OpLine / OpSource and friends from the stored SPIR-V. Reflection is taken before stripping,
+    // so names are still there, but cross compiling a stripped module produces _123 style identifiers.
+    bool stripDebugInfo = true;
+
+    // Renumbers ids densely from 1, which keeps most of them inside one varint byte.
+    bool compactIds = true;
+};
+
+// Builds a pack in memory and writes it out in one go.
+class SHADERPIPE_API ShaderPackWriter {
+public:
+    explicit ShaderPackWriter(ShaderPackOptions options = {});
+
+    // Encodes right away, only the compressed form is kept. Adding a key twice replaces the earlier entry.
+    void add(const ShaderHash& key, const CompiledShader& shader);
+
+    size_t size() const { return entries.size(); }
+
+    std::vector<uint8_t> serialize() const;
+
+    // Written next to path and renamed over it, readers never see a half written pack.
+    bool write(const std::filesystem::path& path) const;
+
+private:
+    struct Entry {
+        std::vector<uint8_t> reflection; // flat binary format, no SPIR-V section
+        std::vector<uint8_t> spirv;      // varint encoded
+        uint32_t spirvWords;
+    };
+
+    ShaderPackOptions options;
+    std::map<ShaderHash, Entry> entries; // sorted, which is the order the index is written in
+};
+
+// Read only, memory mapped pack. Lookups binary search the index in place and only decode the one module asked
+// for, so nothing is read beyond the pages that get touched. Every const member is safe to call from many threads.
+class SHADERPIPE_API ShaderPack {
+public:
+    // Returns false for a missing, truncated or foreign file.
+    bool open  (const std::filesystem::path& path);
+    void close ();
+
+    bool   is_open () const { return file.is_open(); }
+    size_t size    () const { return entryCount; }
+
+    bool contains(const ShaderHash& key) const;
+
+    // Straight from the mapping, no decoding. The view's SPIR-V is empty, use load / load_spirv for that.
+    std::optional<ShaderBinaryView>      reflection (const ShaderHash& key) const;
+
+    std::optional<std::vector<uint32_t>> load_spirv (const ShaderHash& key) const;
+    std::optional<CompiledShader>        load       (const ShaderHash& key) const;
+
+    struct IndexEntry; // one record of the on disk index, defined with the format in shader_pack.cpp
+
+private:
+    const IndexEntry* find(const ShaderHash& key) const;
+
+    MappedFile file;
+    const uint8_t* index = nullptr;
+    size_t entryCount = 0;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_PACK_HPP
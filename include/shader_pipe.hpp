@@ -1,110 +1,144 @@
-/*
-* File: shader_pipe
-* Project: shader-pipe
-* Author: Collin Longoria
-* Created on: 10/2/2025
-*
-* Copyright (c) 2025 Collin Longoria
-*
-* This software is released under the MIT License.
-* https://opensource.org/licenses/MIT
-*/
-
-#ifndef SHADER_PIPE_SHADER_PIPE_HPP
-#define SHADER_PIPE_SHADER_PIPE_HPP
-
-#include <cstdint>
-#include <string>
-#include <vector>
-#include <vulkan/vulkan_core.h>
-
-#ifdef SHADERPIPE_EXPORTS
-    #define SHADERPIPE_API __declspec(dllexport)
-#else
-    #define SHADERPIPE_API __declspec(dllimport)
-#endif
-
-namespace shaderpipe {
-enum class ShaderStage : uint32_t {
-    VERTEX,
-    TESS_CONTROL,
-    TESS_EVAL,
-    GEOMETRY,
-    FRAGMENT,
-    COMPUTE,
-    RAYGEN,
-    RAYGEN_NV = RAYGEN,
-    INTERSECT,
-    INTERSECT_NV = INTERSECT,
-    ANY_HIT,
-    ANY_HIT_NV = ANY_HIT,
-    CLOSEST_HIT,
-    CLOSEST_HIT_NV = CLOSEST_HIT,
-    MISS,
-    MISS_NV = MISS,
-    CALLABLE,
-    CALLABLE_NV = CALLABLE,
-    TASK,
-    TASK_NV = TASK,
-    MESH,
-    MESH_NV = MESH,
-}; // Same ones as provided in glslang
-
-enum class GlVersion : uint32_t {
-    GL_310, // Mobile / Web
-    GL_330, // Compatibility
-    GL_450, // Desktop
-};
-
-// This enum will also determine the spir-v compiler version.
-enum class VKVersion : uint32_t {
-    VK_1_0,
-    VK_1_1,
-    VK_1_2,
-    VK_1_3,
-    VK_1_4,
-};
-
-struct SHADERPIPE_API DescriptorBindingInfo {
-    uint32_t set;
-    uint32_t binding;
-    std::string name;
-    VkDescriptorType type;
-    uint32_t count;
-    VkShaderStageFlags stageFlags;
-};
-
-struct SHADERPIPE_API PushConstantInfo {
-    uint32_t offset;
-    uint32_t size;
-    VkShaderStageFlags stageFlags;
-};
-
-struct SHADERPIPE_API InputAttributeInfo {
-    uint32_t location;
-    std::string name;
-    uint32_t vecSize;
-    uint32_t bitWidth;
-};
-
-struct SHADERPIPE_API ShaderReflection {
-    std::vector<DescriptorBindingInfo> descriptorBindings;
-    std::vector<PushConstantInfo> pushConstants;
-    std::vector<InputAttributeInfo> inputs;
-    std::vector<InputAttributeInfo> outputs;
-};
-
-struct SHADERPIPE_API CompiledShader {
-    std::vector<uint32_t> spirv;
-    ShaderReflection reflection;
-};
-
-SHADERPIPE_API uint32_t              get_glsl_version              (const std::string& source);
-SHADERPIPE_API std::string           load_shader_file              (const std::string& filename);
-SHADERPIPE_API std::vector<uint32_t> glsl_to_spirv                 (const std::string& source, ShaderStage stage, VKVersion targetVulkanVersion);
-SHADERPIPE_API ShaderReflection      reflect_spirv                 (const std::vector<uint32_t>& source);
-SHADERPIPE_API CompiledShader      glsl_to_spirv_with_reflection   (const std::string& source, ShaderStage stage, VKVersion targetVulkanVersion) noexcept;
-SHADERPIPE_API std::string           spirv_to_glsl                 (const std::vector<uint32_t>& source, GlVersion version = GlVersion::GL_450);
-}
-
+/*
+* File: shader_pipe
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/2/2025
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_PIPE_HPP
+#define SHADER_PIPE_SHADER_PIPE_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <vulkan/vulkan_core.h>
+
+#if defined(_WIN32)
+    #ifdef SHADERPIPE_EXPORTS
+        #define SHADERPIPE_API __declspec(dllexport)
+    #else
+        #define SHADERPIPE_API __declspec(dllimport)
+    #endif
+#else
+    #define SHADERPIPE_API __attribute__((visibility("default")))
+#endif
+
+namespace shaderpipe {
+enum class ShaderStage : uint32_t {
+    VERTEX,
+    TESS_CONTROL,
+    TESS_EVAL,
+    GEOMETRY,
+    FRAGMENT,
+    COMPUTE,
+    RAYGEN,
+    RAYGEN_NV = RAYGEN,
+    INTERSECT,
+    INTERSECT_NV = INTERSECT,
+    ANY_HIT,
+    ANY_HIT_NV = ANY_HIT,
+    CLOSEST_HIT,
+    CLOSEST_HIT_NV = CLOSEST_HIT,
+    MISS,
+    MISS_NV = MISS,
+    CALLABLE,
+    CALLABLE_NV = CALLABLE,
+    TASK,
+    TASK_NV = TASK,
+    MESH,
+    MESH_NV = MESH,
+}; // Same ones as provided in glslang
+
+enum class GlVersion : uint32_t {
+    GL_310, // Mobile / Web, GLSL ES 3.10
+    GL_330, // Compatibility
+    GL_450, // Desktop
+};
+
+// This enum will also determine the spir-v compiler version.
+enum class VKVersion : uint32_t {
+    VK_1_0,
+    VK_1_1,
+    VK_1_2,
+    VK_1_3,
+    VK_1_4,
+};
+
+struct SHADERPIPE_API DescriptorBindingInfo {
+    uint32_t set;
+    uint32_t binding;
+    std::string name;
+    VkDescriptorType type;
+    uint32_t count;
+    VkShaderStageFlags stageFlags;
+};
+
+struct SHADERPIPE_API PushConstantInfo {
+    uint32_t offset;
+    uint32_t size;
+    VkShaderStageFlags stageFlags;
+};
+
+enum class ScalarType : uint32_t {
+    BOOL,
+    INT,
+    UINT,
+    FLOAT,
+};
+
+struct SHADERPIPE_API InputAttributeInfo {
+    uint32_t location;
+    std::string name;
+    uint32_t vecSize;   // components per column
+    uint32_t bitWidth;  // per component
+    ScalarType baseType = ScalarType::FLOAT;
+    uint32_t columns = 1;   // > 1 for matrices, each column takes its own location
+    uint32_t arraySize = 1; // every dimension multiplied together, each element takes its own location(s)
+};
+
+struct SHADERPIPE_API SpecConstantInfo {
+    uint32_t constantId; // layout(constant_id = N), what VkSpecializationMapEntry::constantID refers to
+    std::string name;
+    ScalarType type;
+    uint32_t bitWidth;
+    uint64_t defaultValue; // raw bits: 0 / 1 for bool, integers sign / zero extended to 64 bits, IEEE 754 for floats
+};
+
+struct SHADERPIPE_API ShaderReflection {
+    std::vector<DescriptorBindingInfo> descriptorBindings;
+    std::vector<PushConstantInfo> pushConstants;
+    std::vector<InputAttributeInfo> inputs;
+    std::vector<InputAttributeInfo> outputs;
+    std::vector<SpecConstantInfo> specConstants;
+
+    // Declared descriptors the entry point never touches, only filled in with ReflectionOptions::activeOnly.
+    std::vector<DescriptorBindingInfo> unusedDescriptorBindings;
+};
+
+struct SHADERPIPE_API ReflectionOptions {
+    // Report only the descriptors, inputs, outputs and push constant blocks the entry point statically uses,
+    // so pipeline layouts do not carry bindings nobody reads. Unused descriptors go to unusedDescriptorBindings.
+    bool activeOnly = false;
+};
+
+struct SHADERPIPE_API CompiledShader {
+    std::vector<uint32_t> spirv;
+    ShaderReflection reflection;
+};
+
+SHADERPIPE_API uint32_t              get_glsl_version              (std::string_view source);
+SHADERPIPE_API std::string           load_shader_file              (const std::string& filename);
+SHADERPIPE_API std::vector<uint32_t> glsl_to_spirv                 (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion);
+SHADERPIPE_API ShaderReflection      reflect_spirv                 (std::span<const uint32_t> source, const ReflectionOptions& options = {});
+SHADERPIPE_API CompiledShader      glsl_to_spirv_with_reflection   (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion);
+SHADERPIPE_API std::string           spirv_to_glsl                 (std::span<const uint32_t> source, GlVersion version = GlVersion::GL_450);
+}
+
 #endif //SHADER_PIPE_SHADER_PIPE_HPP
\ No newline at end of file
@@ -0,0 +1,45 @@
+/*
+* File: shader_program
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_PROGRAM_HPP
+#define SHADER_PIPE_SHADER_PROGRAM_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_hash.hpp"
+
+namespace shaderpipe {
+
+// One VkDescriptorSetLayout worth of bindings, sorted by binding number.
+struct SHADERPIPE_API DescriptorSetLayoutInfo {
+    uint32_t set;
+    std::vector<DescriptorBindingInfo> bindings;
+    ShaderHash hash; // see hash_set_layout
+};
+
+// Everything needed to create the VkPipelineLayout of a whole program (vertex + fragment, mesh + task + fragment, ...).
+struct SHADERPIPE_API ProgramReflection {
+    std::vector<DescriptorSetLayoutInfo> setLayouts; // sorted by set, only sets that are used
+    std::vector<PushConstantInfo> pushConstants;     // no stage appears in more than one range
+    VkShaderStageFlags stages = 0; // every stage that uses at least one descriptor or push constant
+};
+
+// Merges per-stage reflection into one program layout. Bindings that share set/binding are merged with their
+// stageFlags OR'd together; throws std::runtime_error if two stages disagree on the type or count of one.
+SHADERPIPE_API ProgramReflection reflect_program (std::span<const ShaderReflection> stages);
+SHADERPIPE_API ProgramReflection reflect_program (std::span<const CompiledShader> stages);
+
+// Covers binding, type, count and stageFlags, not names, so two programs declaring the same layout under different
+// names hash the same and can share one VkDescriptorSetLayout. Stable across runs and processes.
+SHADERPIPE_API ShaderHash hash_set_layout (std::span<const DescriptorBindingInfo> bindings);
+}
+
+#endif //SHADER_PIPE_SHADER_PROGRAM_HPP
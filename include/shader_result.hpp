@@ -0,0 +1,130 @@
+/*
+* File: shader_result
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_RESULT_HPP
+#define SHADER_PIPE_SHADER_RESULT_HPP
+
+#include "shader_pipe.hpp"
+
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace shaderpipe {
+
+enum class StatusCode : uint32_t {
+    OK,
+    PREPROCESS_FAILED,    // #include, #if, macros
+    COMPILE_FAILED,       // glslang parse
+    LINK_FAILED,          // glslang link
+    OPTIMIZE_FAILED,      // spirv-opt, including validation
+    INVALID_SPIRV,        // the module given to reflect / cross compile could not be parsed
+    CROSS_COMPILE_FAILED,
+    CANCELLED,            // CompileOptions::cancelFlag was set
+    INTERNAL_ERROR,       // anything else, out of memory included
+};
+
+SHADERPIPE_API const char* status_code_name(StatusCode code);
+
+// Status plus value, along the lines of std::expected. value() on a failed result throws std::runtime_error.
+template<typename T>
+class Result {
+public:
+    Result(T value) : storage(std::move(value)) {}
+    // A failure. StatusCode::OK carries no value to go with it, so it is taken as INTERNAL_ERROR rather than
+    // producing an ok() result whose value() reads an empty optional.
+    Result(StatusCode code) : code(code == StatusCode::OK ? StatusCode::INTERNAL_ERROR : code) {}
+
+    bool ok() const { return code == StatusCode::OK; }
+    explicit operator bool() const { return ok(); }
+    StatusCode status() const { return code; }
+
+    T&       value() &       { check(); return *storage; }
+    const T& value() const&  { check(); return *storage; }
+    T&&      value() &&      { check(); return std::move(*storage); }
+
+    T&       operator*  () &      { return value(); }
+    const T& operator*  () const& { return value(); }
+    T*       operator-> ()        { return &value(); }
+    const T* operator-> () const  { return &value(); }
+
+    T value_or(T fallback) const& { return ok() ? *storage : std::move(fallback); }
+    T value_or(T fallback) &&     { return ok() ? std::move(*storage) : std::move(fallback); }
+
+private:
+    void check() const {
+        if (!ok())
+            throw std::runtime_error(std::string("Result holds no value: ") + status_code_name(code));
+    }
+
+    StatusCode code = StatusCode::OK;
+    std::optional<T> storage;
+};
+
+enum class DiagnosticSeverity : uint32_t {
+    ERROR,
+    WARNING,
+    NOTE, // anything without a recognized prefix
+};
+
+// Views into the owning DiagnosticBuffer, valid until its next use.
+struct SHADERPIPE_API Diagnostic {
+    DiagnosticSeverity severity;
+    std::string_view file;    // sourcePath, an included header, or glslang's string index ("0") without one
+    uint32_t line;            // 1 based, 0 when the message is not about one place (link errors)
+    uint32_t column;          // 1 based, 0 when glslang did not report one
+    std::string_view message;
+};
+
+// Holds the diagnostics of one failed call. Meant to be kept and passed to every call: clearing keeps the
+// memory, so once it has grown to fit a log, repeated failing compiles do not allocate in here.
+class SHADERPIPE_API DiagnosticBuffer {
+public:
+    DiagnosticBuffer() = default;
+    DiagnosticBuffer(const DiagnosticBuffer& other);
+    DiagnosticBuffer(DiagnosticBuffer&& other) noexcept;
+    DiagnosticBuffer& operator=(const DiagnosticBuffer& other);
+    DiagnosticBuffer& operator=(DiagnosticBuffer&& other) noexcept;
+
+    std::span<const Diagnostic> diagnostics () const { return entries; }
+    std::string_view            log         () const { return text; } // unparsed, what the throwing API reports
+    size_t                      error_count () const;
+    bool                        empty       () const { return text.empty(); }
+
+    void clear();
+
+    // Replaces the contents with a glslang style info log ("ERROR: file:line: message" per line) and parses it.
+    // Lines in no known format are kept as notes, glslang's closing error count is dropped.
+    void set_log(std::string_view log);
+
+    // Replaces the contents with one error that is not about a place in the source. Should the message not fit
+    // in memory the buffer is only cleared, so it is safe to call while handling a failure.
+    void set_error(std::string_view message) noexcept;
+
+private:
+    void rebase(const char* oldText); // points the views at text after it moved
+
+    std::string text;
+    std::vector<Diagnostic> entries;
+};
+
+// Never throw for errors in the shader or the module, the result carries the status and diagnostics receives
+// the details (cleared on success).
+SHADERPIPE_API Result<CompiledShader>   try_glsl_to_spirv_with_reflection (std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                                           DiagnosticBuffer& diagnostics) noexcept;
+SHADERPIPE_API Result<ShaderReflection> try_reflect_spirv                 (std::span<const uint32_t> source, DiagnosticBuffer& diagnostics,
+                                                                           const ReflectionOptions& options = {}) noexcept;
+SHADERPIPE_API Result<std::string>      try_spirv_to_glsl                 (std::span<const uint32_t> source, DiagnosticBuffer& diagnostics,
+                                                                           GlVersion version = GlVersion::GL_450) noexcept;
+}
+
+#endif //SHADER_PIPE_SHADER_RESULT_HPP
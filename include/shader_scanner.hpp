@@ -0,0 +1,93 @@
+/*
+* File: shader_scanner
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_SCANNER_HPP
+#define SHADER_PIPE_SHADER_SCANNER_HPP
+
+#include "shader_pipe.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+
+namespace shaderpipe {
+class ThreadPool;
+
+// #extension <name> : <behavior>
+struct SHADERPIPE_API ShaderExtension {
+    std::string name;
+    std::string behavior; // require, enable, warn or disable
+};
+
+struct SHADERPIPE_API ShaderIncludeDirective {
+    std::string name; // as written between the quotes / brackets
+    bool system;      // <name> rather than "name"
+    uint32_t line;
+};
+
+// Directives found by a plain text scan: comments are skipped, everything else (#if, macros) is not evaluated,
+// so includes and extensions inside inactive branches are reported too. Build systems want that superset anyway.
+struct SHADERPIPE_API ShaderScanInfo {
+    uint32_t version = 0;                          // 0 without a #version
+    std::string profile;                           // core, compatibility, es or empty
+    std::vector<ShaderExtension> extensions;
+    std::vector<ShaderIncludeDirective> includes;  // source order
+    std::optional<ShaderStage> stage;              // #pragma shader_stage(<name>), same spelling as shaderc
+};
+
+SHADERPIPE_API ShaderScanInfo scan_shader (std::string_view source);
+
+// .vert, .frag, .comp, ... also behind a trailing .glsl (shadow.vert.glsl).
+SHADERPIPE_API std::optional<ShaderStage> stage_from_extension (const std::filesystem::path& path);
+
+struct SHADERPIPE_API ShaderDependencies {
+    std::string path;                           // the shader, canonical
+    ShaderScanInfo info;                        // of the shader itself; stage falls back to the file extension
+    std::vector<std::string> includes;          // every header reached, transitively, canonical, in discovery order
+    std::vector<std::string> missing;           // include names that resolved nowhere
+    std::vector<ShaderExtension> extensions;    // the shader's and every header's, first occurrence of each name
+    std::string error;                          // scan_all only: why the shader could not be read, empty on success
+};
+
+// Finds the include set of shaders without running glslang. Includes resolve the way the compiler resolves them:
+// "" next to the including file first, then includeDirectories in order. Every header is read and scanned once per
+// scanner and then shared by all the shaders including it, so keep one around for a whole tree. Thread safe.
+class SHADERPIPE_API DependencyScanner {
+public:
+    explicit DependencyScanner(std::vector<std::filesystem::path> includeDirectories = {});
+    ~DependencyScanner();
+
+    DependencyScanner(const DependencyScanner&) = delete;
+    DependencyScanner& operator=(const DependencyScanner&) = delete;
+
+    // Throws if shader itself can not be read, unreadable headers end up in missing.
+    ShaderDependencies scan(const std::filesystem::path& shader) const;
+
+    // Spread over the pool, results in input order. A shader that can not be read comes back with its path, no
+    // includes and error set.
+    std::vector<ShaderDependencies> scan_all(std::span<const std::filesystem::path> shaders, ThreadPool& pool) const;
+    std::vector<ShaderDependencies> scan_all(std::span<const std::filesystem::path> shaders) const; // default_thread_pool()
+
+    // Drops the cached headers, for when they changed on disk.
+    void clear();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+// Make / Ninja depfile: "target: shader header...", with spaces, '#' and '$' escaped.
+SHADERPIPE_API std::string make_depfile  (std::string_view target, const ShaderDependencies& deps);
+SHADERPIPE_API bool        write_depfile (const std::filesystem::path& depfile, std::string_view target, const ShaderDependencies& deps);
+}
+
+#endif //SHADER_PIPE_SHADER_SCANNER_HPP
@@ -0,0 +1,55 @@
+/*
+* File: shader_thread_pool
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_THREAD_POOL_HPP
+#define SHADER_PIPE_SHADER_THREAD_POOL_HPP
+
+#include "shader_pipe.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace shaderpipe {
+
+// Work stealing thread pool.
+// Every worker owns a deque. Workers pop their own work LIFO and steal FIFO from the others when they run dry,
+// so uneven jobs (one huge uber shader next to hundreds of tiny ones) still keep every core busy.
+class SHADERPIPE_API ThreadPool {
+public:
+    // 0 => std::thread::hardware_concurrency()
+    explicit ThreadPool(uint32_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32_t thread_count() const;
+
+    // Fire and forget. Tasks submitted from inside a worker land on that worker's own deque.
+    void submit(std::function<void()> task);
+
+    // Runs body(i) for every i in [0, count) and blocks until all of them finished.
+    // The calling thread helps out while it waits, so this is safe to call from inside a task as well.
+    // The first exception thrown by body is rethrown here once everything is done.
+    void parallel_for(size_t count, const std::function<void(size_t)>& body);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+// Lazily created pool sized to the machine.
+SHADERPIPE_API ThreadPool& default_thread_pool();
+}
+
+#endif //SHADER_PIPE_SHADER_THREAD_POOL_HPP
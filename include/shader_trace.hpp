@@ -0,0 +1,116 @@
+/*
+* File: shader_trace
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_TRACE_HPP
+#define SHADER_PIPE_SHADER_TRACE_HPP
+
+#include "shader_pipe.hpp"
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+
+namespace shaderpipe {
+
+enum class TracePhase : uint32_t {
+    PREPROCESS,
+    PARSE,          // glslang TShader::parse
+    LINK,           // glslang TProgram::link
+    SPIRV_GEN,      // GlslangToSpv
+    OPTIMIZE,       // spirv-opt, including validation
+    REFLECT,
+    CROSS_COMPILE,  // spirv-cross parse + GLSL codegen
+    CACHE_LOOKUP,
+    CACHE_STORE,
+    COUNT,
+};
+
+SHADERPIPE_API const char* trace_phase_name(TracePhase phase);
+
+enum class CacheResult : uint32_t {
+    NOT_CACHED, // no cache involved
+    HIT,        // served from the memory or disk cache
+    MISS,
+};
+
+// One top level call (glsl_to_spirv, reflect_spirv, spirv_to_glsl, ...). Nested calls are folded into the outer one.
+struct SHADERPIPE_API CompileStats {
+    const char* operation = "";
+    std::string name;                   // CompileOptions::sourcePath, when there is one
+    std::optional<ShaderStage> stage;   // unknown for calls that start from SPIR-V
+    std::array<uint64_t, static_cast<size_t>(TracePhase::COUNT)> phaseNs{};
+    uint64_t beginNs = 0;               // since the first traced call in this process
+    uint64_t totalNs = 0;
+    size_t spirvWords = 0;
+    // Heap in use by the whole process when the call finished, not by this call alone: concurrent compiles all show
+    // up in it. Sampled once per top level call, 0 where the allocator can not report its usage (glibc only for now).
+    size_t processHeapBytes = 0;
+    CacheResult cache = CacheResult::NOT_CACHED;
+    uint32_t threadId = 0;
+    bool success = false;
+
+    uint64_t phase_ns(TracePhase phase) const { return phaseNs[static_cast<size_t>(phase)]; }
+};
+
+struct SHADERPIPE_API TraceEvent {
+    TracePhase phase;
+    const CompileStats* compile; // the call the phase belongs to, still in progress
+    uint64_t beginNs;
+    uint64_t durationNs;
+};
+
+// Receives events from every thread that compiles, implementations have to be thread safe.
+class SHADERPIPE_API TraceSink {
+public:
+    virtual ~TraceSink() = default;
+
+    virtual void on_phase   (const TraceEvent&) {}
+    virtual void on_compile (const CompileStats&) {}
+};
+
+// Installs sink for the whole process, nullptr turns tracing off. With no sink installed every instrumentation
+// point reduces to one relaxed atomic load: no clocks are read and nothing is allocated.
+SHADERPIPE_API void set_trace_sink (std::shared_ptr<TraceSink> sink);
+SHADERPIPE_API std::shared_ptr<TraceSink> get_trace_sink ();
+
+// Forwards finished compiles to a function.
+class SHADERPIPE_API CallbackTraceSink : public TraceSink {
+public:
+    explicit CallbackTraceSink(std::function<void(const CompileStats&)> callback) : callback(std::move(callback)) {}
+
+    void on_compile(const CompileStats& stats) override { callback(stats); }
+
+private:
+    std::function<void(const CompileStats&)> callback;
+};
+
+// Records everything in Chrome's trace event format: open the file in chrome://tracing or ui.perfetto.dev.
+class SHADERPIPE_API ChromeTraceSink : public TraceSink {
+public:
+    void on_phase   (const TraceEvent& event) override;
+    void on_compile (const CompileStats& stats) override;
+
+    void write (std::ostream& out) const;
+    bool save  (const std::filesystem::path& path) const;
+    void clear ();
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::string> events; // already formatted
+};
+}
+
+#endif //SHADER_PIPE_SHADER_TRACE_HPP
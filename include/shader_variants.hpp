@@ -0,0 +1,68 @@
+/*
+* File: shader_variants
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_VARIANTS_HPP
+#define SHADER_PIPE_SHADER_VARIANTS_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_compiler.hpp"
+#include "shader_thread_pool.hpp"
+
+#include <optional>
+
+namespace shaderpipe {
+
+// One independent #define switch. Every permutation picks exactly one value per axis; nullopt leaves the name undefined.
+struct SHADERPIPE_API DefineAxis {
+    std::string name;
+    std::vector<std::optional<std::string>> values;
+
+    // #ifdef style switch: undefined / defined.
+    static DefineAxis toggle(std::string name) { return { std::move(name), { std::nullopt, std::string() } }; }
+};
+
+// Every permutation of one source. Outputs that came out bit identical are stored once, so memory follows the number
+// of distinct modules rather than the number of permutations.
+struct SHADERPIPE_API VariantSet {
+    static constexpr uint32_t InvalidModule = UINT32_MAX;
+
+    std::vector<CompiledShader> modules;      // unique outputs
+    std::vector<ShaderHash> moduleHashes;     // SPIR-V hash, parallel to modules
+    std::vector<uint32_t> permutationModules; // permutation index -> modules index, InvalidModule when it failed to compile
+    std::vector<std::pair<uint32_t, std::string>> errors; // permutation index, info log
+
+    // Axis sizes when built from axes, empty for an explicit permutation list.
+    std::vector<uint32_t> axisSizes;
+
+    size_t permutation_count() const { return permutationModules.size(); }
+
+    // Mixed radix over the axes, the first axis varies fastest. choices[i] indexes axes[i].values.
+    uint32_t permutation_index(std::span<const uint32_t> choices) const;
+
+    // nullptr if that permutation failed.
+    const CompiledShader* find(uint32_t permutation) const;
+};
+
+// Compiles every combination of axes (on top of options.defines) across the pool.
+// Permutations are preprocessed first and only the ones whose preprocessed text differs get compiled, so switches a
+// source does not actually depend on cost one preprocessor pass instead of a full compile.
+SHADERPIPE_API VariantSet compile_variants(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                           std::span<const DefineAxis> axes, const CompileOptions& options = {},
+                                           ThreadPool& pool = default_thread_pool());
+
+// Same, for an explicit list of define sets. Permutation i is permutations[i].
+SHADERPIPE_API VariantSet compile_variants(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                           std::span<const std::vector<ShaderDefine>> permutations, const CompileOptions& options = {},
+                                           ThreadPool& pool = default_thread_pool());
+}
+
+#endif //SHADER_PIPE_SHADER_VARIANTS_HPP
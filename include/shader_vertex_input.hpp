@@ -0,0 +1,66 @@
+/*
+* File: shader_vertex_input
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_VERTEX_INPUT_HPP
+#define SHADER_PIPE_SHADER_VERTEX_INPUT_HPP
+
+#include "shader_pipe.hpp"
+
+namespace shaderpipe {
+
+enum class VertexLayout : uint32_t {
+    INTERLEAVED,  // one binding, every attribute of a vertex next to each other in location order
+    PER_LOCATION, // one binding per location, each attribute in its own tightly packed stream
+};
+
+// Stores one location in a different format than the shader reads it, e.g. VK_FORMAT_A2B10G10R10_SNORM_PACK32
+// for a normal the shader declares as vec4. The hardware converts on fetch, the shader stays unchanged.
+struct SHADERPIPE_API VertexFormatOverride {
+    uint32_t location;
+    VkFormat format;
+};
+
+struct SHADERPIPE_API VertexInputOptions {
+    VertexLayout layout = VertexLayout::INTERLEAVED;
+    VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    uint32_t firstBinding = 0;
+
+    // 32 bit float attributes are fetched from 16 bit floats. Three component vectors are padded to four,
+    // R16G16B16_SFLOAT is rarely supported as a vertex format.
+    bool halfFloats = false;
+
+    // Wins over halfFloats. Locations not in the shader are ignored.
+    std::vector<VertexFormatOverride> overrides;
+};
+
+// Everything VkPipelineVertexInputStateCreateInfo points to. Attributes come sorted by location.
+struct SHADERPIPE_API VertexInputLayout {
+    std::vector<VkVertexInputBindingDescription> bindings;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+
+    // Points into this object, it has to outlive the pipeline creation call.
+    VkPipelineVertexInputStateCreateInfo create_info() const;
+};
+
+// Builds the vertex input state for a vertex shader's reflected inputs. Matrices take one attribute per column,
+// arrays one per element, 64 bit three and four component vectors two locations each, as the shader sees them.
+// Offsets are aligned to each format's component size and strides to the largest one in the binding.
+// Throws std::runtime_error for inputs that can not be fed from a vertex buffer (bool).
+SHADERPIPE_API VertexInputLayout generate_vertex_input (std::span<const InputAttributeInfo> inputs, const VertexInputOptions& options = {});
+
+// The format that feeds such an attribute without conversion, VK_FORMAT_UNDEFINED if there is none.
+SHADERPIPE_API VkFormat vertex_format      (ScalarType type, uint32_t bitWidth, uint32_t components);
+// Bytes one element of format takes in a vertex buffer, 0 for formats that are not vertex formats.
+SHADERPIPE_API uint32_t vertex_format_size (VkFormat format);
+}
+
+#endif //SHADER_PIPE_SHADER_VERTEX_INPUT_HPP
@@ -0,0 +1,65 @@
+/*
+* File: shader_watcher
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_WATCHER_HPP
+#define SHADER_PIPE_SHADER_WATCHER_HPP
+
+#include "shader_pipe.hpp"
+#include "shader_compiler.hpp"
+#include "shader_dependency_graph.hpp"
+
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+namespace shaderpipe {
+
+struct SHADERPIPE_API WatchedShader {
+    std::filesystem::path path;
+    ShaderStage stage;
+    VKVersion targetVulkanVersion;
+    CompileOptions options{}; // sourcePath is filled in from path when left empty
+};
+
+// Called after every (re)compile, on the watcher thread or on the thread calling add / notify_changed. Rebuilds are
+// serialized, so calls never overlap and come in the order the compiles finished: no locking needed in the callback.
+using ShaderRebuiltCallback = std::function<void(const WatchedShader& shader, const BatchResult& result)>;
+
+// Hot reload: watches every shader plus everything it includes and recompiles only the shaders whose
+// (transitive) includes changed. Uses inotify on Linux, falls back to polling modification times elsewhere.
+class SHADERPIPE_API ShaderWatcher {
+public:
+    ShaderWatcher(const Compiler& compiler, ShaderRebuiltCallback callback);
+    ~ShaderWatcher(); // stops the watch thread
+
+    ShaderWatcher(const ShaderWatcher&) = delete;
+    ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+    // Compiles the shader once (reported through the callback) and records its includes.
+    void add    (WatchedShader shader);
+    void remove (const std::filesystem::path& path);
+
+    void start ();
+    void stop  ();
+
+    // Rebuilds every shader affected by a change to file. The watch thread calls this, it can also be driven by hand.
+    void notify_changed(const std::filesystem::path& file);
+
+    DependencyGraph& graph();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_WATCHER_HPP
@@ -0,0 +1,238 @@
+/*
+* File: shader_async
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_async.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace shaderpipe {
+
+struct CompileHandle::State {
+    std::weak_ptr<AsyncCompiler::Impl> owner;
+
+    std::promise<CompiledShader> promise;
+    std::shared_future<CompiledShader> future;
+    std::shared_ptr<std::atomic<bool>> cancelFlag = std::make_shared<std::atomic<bool>>(false);
+
+    std::string source;
+    ShaderStage stage;
+    VKVersion targetVulkanVersion;
+    CompileOptions options;
+
+    // Guarded by the owner's mutex.
+    int32_t priority = 0;
+    uint64_t sequence = 0;
+    bool queued = false;
+};
+
+struct AsyncCompiler::Impl {
+    Impl(const Compiler& compiler, AsyncCompilerOptions options) : compiler(compiler), options(options) {}
+
+    using State = CompileHandle::State;
+
+    // Highest priority first, submission order within a priority.
+    struct QueueKey {
+        int32_t priority;
+        uint64_t sequence;
+        State* state;
+
+        bool operator<(const QueueKey& other) const {
+            if (priority != other.priority)
+                return priority > other.priority;
+            return sequence < other.sequence;
+        }
+    };
+
+    const Compiler& compiler;
+    AsyncCompilerOptions options;
+
+    std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable space;
+    std::set<QueueKey> queue;
+    std::unordered_map<State*, std::shared_ptr<State>> pending; // keeps queued states alive, the queue only has raw pointers
+    std::unordered_set<State*> running;
+    uint64_t nextSequence = 0;
+    bool stopping = false;
+
+    std::vector<std::thread> workers;
+
+    void run();
+    void unqueue(State& state); // mutex held
+    std::optional<CompileHandle> submit(std::shared_ptr<Impl> self, std::string source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                        CompileOptions options, CompilePriority priority, bool block);
+};
+
+void AsyncCompiler::Impl::unqueue(State& state) {
+    queue.erase({ state.priority, state.sequence, &state });
+    state.queued = false;
+    space.notify_one();
+}
+
+void AsyncCompiler::Impl::run() {
+    for (;;) {
+        std::shared_ptr<State> state;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            work.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping)
+                return;
+
+            State* next = queue.begin()->state;
+            unqueue(*next);
+            auto it = pending.find(next);
+            state = std::move(it->second);
+            pending.erase(it);
+            running.insert(next);
+        }
+
+        try {
+            state->promise.set_value(compiler.glsl_to_spirv_with_reflection(state->source, state->stage, state->targetVulkanVersion, state->options));
+        } catch (...) {
+            state->promise.set_exception(std::current_exception());
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        running.erase(state.get());
+        state->source = {};
+    }
+}
+
+std::optional<CompileHandle> AsyncCompiler::Impl::submit(std::shared_ptr<Impl> self, std::string source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                         CompileOptions compileOptions, CompilePriority priority, bool block) {
+    auto state = std::make_shared<State>();
+    state->owner = self;
+    state->future = state->promise.get_future().share();
+    state->source = std::move(source);
+    state->stage = stage;
+    state->targetVulkanVersion = targetVulkanVersion;
+    state->options = std::move(compileOptions);
+    state->options.cancelFlag = state->cancelFlag;
+    state->priority = static_cast<int32_t>(priority);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    const auto hasSpace = [this] { return stopping || queue.size() < std::max<size_t>(options.maxQueued, 1); };
+    if (block)
+        space.wait(lock, hasSpace);
+    else if (!hasSpace())
+        return std::nullopt;
+    if (stopping)
+        throw std::runtime_error("AsyncCompiler is shutting down.");
+
+    state->sequence = nextSequence++;
+    state->queued = true;
+    queue.insert({ state->priority, state->sequence, state.get() });
+    pending.emplace(state.get(), state);
+    work.notify_one();
+    return CompileHandle(std::move(state));
+}
+
+AsyncCompiler::AsyncCompiler(const Compiler& compiler, AsyncCompilerOptions options)
+    : impl(std::make_shared<Impl>(compiler, options)) {
+    uint32_t threads = options.threadCount;
+    if (threads == 0) {
+        const uint32_t hw = std::thread::hardware_concurrency();
+        threads = hw > 1 ? hw - 1 : 1;
+    }
+    impl->workers.reserve(threads);
+    for (uint32_t i = 0; i < threads; ++i)
+        impl->workers.emplace_back([impl = impl.get()] { impl->run(); });
+}
+
+AsyncCompiler::~AsyncCompiler() {
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->stopping = true;
+        for (const auto& [key, state] : impl->pending) {
+            state->queued = false;
+            state->cancelFlag->store(true);
+            state->promise.set_exception(std::make_exception_ptr(CompileCancelled()));
+        }
+        impl->queue.clear();
+        impl->pending.clear();
+        for (auto* state : impl->running)
+            state->cancelFlag->store(true);
+    }
+    impl->work.notify_all();
+    impl->space.notify_all();
+    for (auto& worker : impl->workers)
+        worker.join();
+}
+
+CompileHandle AsyncCompiler::compile_async(std::string source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                           CompileOptions options, CompilePriority priority) {
+    return *impl->submit(impl, std::move(source), stage, targetVulkanVersion, std::move(options), priority, true);
+}
+
+std::optional<CompileHandle> AsyncCompiler::try_compile_async(std::string source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                              CompileOptions options, CompilePriority priority) {
+    return impl->submit(impl, std::move(source), stage, targetVulkanVersion, std::move(options), priority, false);
+}
+
+size_t AsyncCompiler::queued() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->queue.size();
+}
+
+const CompiledShader& CompileHandle::get() const {
+    return state->future.get();
+}
+
+void CompileHandle::wait() const {
+    state->future.wait();
+}
+
+bool CompileHandle::ready() const {
+    return state->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void CompileHandle::cancel() const {
+    state->cancelFlag->store(true);
+
+    auto owner = state->owner.lock();
+    if (!owner)
+        return;
+
+    std::lock_guard<std::mutex> lock(owner->mutex);
+    if (!state->queued)
+        return; // running (the compiler checks the flag between phases) or already done
+
+    owner->unqueue(*state);
+    owner->pending.erase(state.get());
+    state->source = {};
+    state->promise.set_exception(std::make_exception_ptr(CompileCancelled()));
+}
+
+bool CompileHandle::cancelled() const {
+    return state->cancelFlag->load();
+}
+
+void CompileHandle::set_priority(CompilePriority priority) const {
+    auto owner = state->owner.lock();
+    if (!owner)
+        return;
+
+    std::lock_guard<std::mutex> lock(owner->mutex);
+    if (!state->queued)
+        return;
+
+    owner->queue.erase({ state->priority, state->sequence, state.get() });
+    state->priority = static_cast<int32_t>(priority);
+    owner->queue.insert({ state->priority, state->sequence, state.get() });
+}
+}
@@ -0,0 +1,247 @@
+/*
+* File: shader_binary
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_binary.hpp"
+
+#include <bit>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace shaderpipe {
+
+static_assert(std::endian::native == std::endian::little, "The shader binary format is read in place, big endian hosts would need a byte swapping reader.");
+static_assert(alignof(binary::Header) == 4 && sizeof(binary::Header) == 19 * sizeof(uint32_t));
+
+namespace {
+class StringTable {
+public:
+    binary::String add(std::string_view str) {
+        auto [it, inserted] = offsets.try_emplace(std::string(str), 0u);
+        if (inserted) {
+            it->second = static_cast<uint32_t>(data.size());
+            data.append(str);
+            data.push_back('\0');
+        }
+        return { it->second, static_cast<uint32_t>(str.size()) };
+    }
+
+    const std::string& bytes() const { return data; }
+
+private:
+    std::string data;
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+uint32_t align4(size_t v) {
+    return static_cast<uint32_t>((v + 3) & ~size_t(3));
+}
+
+bool section_in_bounds(const binary::Section& section, size_t recordSize, size_t blobSize) {
+    return section.offset % 4 == 0 &&
+           static_cast<uint64_t>(section.offset) + static_cast<uint64_t>(section.count) * recordSize <= blobSize;
+}
+
+bool string_in_bounds(const binary::String& str, const binary::Section& strings, const uint8_t* base) {
+    // The NUL after the string has to be inside the table too.
+    return static_cast<uint64_t>(str.offset) + str.length < strings.count &&
+           base[strings.offset + str.offset + str.length] == '\0';
+}
+}
+
+DescriptorBindingInfo DescriptorBindingView::to_info() const {
+    return { set(), binding(), std::string(name()), type(), count(), stageFlags() };
+}
+
+PushConstantInfo PushConstantView::to_info() const {
+    return { offset(), size(), stageFlags() };
+}
+
+InputAttributeInfo AttributeView::to_info() const {
+    return { location(), std::string(name()), vecSize(), bitWidth(), baseType(), columns(), arraySize() };
+}
+
+SpecConstantInfo SpecConstantView::to_info() const {
+    return { constantId(), std::string(name()), type(), bitWidth(), defaultValue() };
+}
+
+std::optional<ShaderBinaryView> ShaderBinaryView::from_bytes(std::span<const uint8_t> data) {
+    if (data.size() < sizeof(binary::Header) || reinterpret_cast<uintptr_t>(data.data()) % 4 != 0)
+        return std::nullopt;
+
+    ShaderBinaryView view(data.data());
+    const auto& h = view.header();
+    if (h.magic != binary::Magic || h.version != binary::Version || h.size < sizeof(binary::Header) || h.size > data.size())
+        return std::nullopt;
+
+    if (!section_in_bounds(h.spirv, sizeof(uint32_t), h.size) ||
+        !section_in_bounds(h.descriptorBindings, sizeof(binary::DescriptorBinding), h.size) ||
+        !section_in_bounds(h.pushConstants, sizeof(binary::PushConstant), h.size) ||
+        !section_in_bounds(h.inputs, sizeof(binary::Attribute), h.size) ||
+        !section_in_bounds(h.outputs, sizeof(binary::Attribute), h.size) ||
+        !section_in_bounds(h.specConstants, sizeof(binary::SpecConstant), h.size) ||
+        !section_in_bounds(h.unusedDescriptorBindings, sizeof(binary::DescriptorBinding), h.size) ||
+        !section_in_bounds(h.strings, 1, h.size))
+        return std::nullopt;
+
+    // One pass over the names so the accessors never have to check anything.
+    for (const auto* section : { &h.descriptorBindings, &h.unusedDescriptorBindings }) {
+        const auto* bindings = view.records<binary::DescriptorBinding>(*section);
+        for (uint32_t i = 0; i < section->count; ++i) {
+            if (!string_in_bounds(bindings[i].name, h.strings, data.data()))
+                return std::nullopt;
+        }
+    }
+    for (const auto* section : { &h.inputs, &h.outputs }) {
+        const auto* attributes = view.records<binary::Attribute>(*section);
+        for (uint32_t i = 0; i < section->count; ++i) {
+            if (!string_in_bounds(attributes[i].name, h.strings, data.data()))
+                return std::nullopt;
+        }
+    }
+    const auto* specConstants = view.records<binary::SpecConstant>(h.specConstants);
+    for (uint32_t i = 0; i < h.specConstants.count; ++i) {
+        if (!string_in_bounds(specConstants[i].name, h.strings, data.data()))
+            return std::nullopt;
+    }
+
+    return view;
+}
+
+std::span<const uint32_t> ShaderBinaryView::spirv() const {
+    return { records<uint32_t>(header().spirv), header().spirv.count };
+}
+
+BinaryTable<binary::DescriptorBinding, DescriptorBindingView> ShaderBinaryView::descriptor_bindings() const {
+    return { records<binary::DescriptorBinding>(header().descriptorBindings), header().descriptorBindings.count, strings() };
+}
+
+BinaryTable<binary::PushConstant, PushConstantView> ShaderBinaryView::push_constants() const {
+    return { records<binary::PushConstant>(header().pushConstants), header().pushConstants.count, strings() };
+}
+
+BinaryTable<binary::Attribute, AttributeView> ShaderBinaryView::inputs() const {
+    return { records<binary::Attribute>(header().inputs), header().inputs.count, strings() };
+}
+
+BinaryTable<binary::Attribute, AttributeView> ShaderBinaryView::outputs() const {
+    return { records<binary::Attribute>(header().outputs), header().outputs.count, strings() };
+}
+
+BinaryTable<binary::SpecConstant, SpecConstantView> ShaderBinaryView::spec_constants() const {
+    return { records<binary::SpecConstant>(header().specConstants), header().specConstants.count, strings() };
+}
+
+BinaryTable<binary::DescriptorBinding, DescriptorBindingView> ShaderBinaryView::unused_descriptor_bindings() const {
+    return { records<binary::DescriptorBinding>(header().unusedDescriptorBindings), header().unusedDescriptorBindings.count, strings() };
+}
+
+CompiledShader ShaderBinaryView::to_compiled_shader() const {
+    CompiledShader shader;
+    const auto words = spirv();
+    shader.spirv.assign(words.begin(), words.end());
+
+    auto& refl = shader.reflection;
+    refl.descriptorBindings.reserve(descriptor_bindings().size());
+    for (const auto b : descriptor_bindings())
+        refl.descriptorBindings.push_back(b.to_info());
+    refl.pushConstants.reserve(push_constants().size());
+    for (const auto pc : push_constants())
+        refl.pushConstants.push_back(pc.to_info());
+    refl.inputs.reserve(inputs().size());
+    for (const auto a : inputs())
+        refl.inputs.push_back(a.to_info());
+    refl.outputs.reserve(outputs().size());
+    for (const auto a : outputs())
+        refl.outputs.push_back(a.to_info());
+    refl.specConstants.reserve(spec_constants().size());
+    for (const auto sc : spec_constants())
+        refl.specConstants.push_back(sc.to_info());
+    refl.unusedDescriptorBindings.reserve(unused_descriptor_bindings().size());
+    for (const auto b : unused_descriptor_bindings())
+        refl.unusedDescriptorBindings.push_back(b.to_info());
+    return shader;
+}
+
+std::vector<uint8_t> write_shader_binary(const CompiledShader& shader) {
+    const auto& refl = shader.reflection;
+
+    StringTable strings;
+    auto descriptors = [&](const std::vector<DescriptorBindingInfo>& in) {
+        std::vector<binary::DescriptorBinding> out;
+        out.reserve(in.size());
+        for (const auto& b : in)
+            out.push_back({ b.set, b.binding, strings.add(b.name), static_cast<uint32_t>(b.type), b.count, b.stageFlags });
+        return out;
+    };
+    const auto bindings = descriptors(refl.descriptorBindings);
+    const auto unusedBindings = descriptors(refl.unusedDescriptorBindings);
+
+    std::vector<binary::PushConstant> pushConstants;
+    pushConstants.reserve(refl.pushConstants.size());
+    for (const auto& pc : refl.pushConstants)
+        pushConstants.push_back({ pc.offset, pc.size, pc.stageFlags });
+
+    auto attributes = [&](const std::vector<InputAttributeInfo>& in) {
+        std::vector<binary::Attribute> out;
+        out.reserve(in.size());
+        for (const auto& a : in)
+            out.push_back({ a.location, strings.add(a.name), a.vecSize, a.bitWidth, static_cast<uint32_t>(a.baseType), a.columns, a.arraySize });
+        return out;
+    };
+    const auto inputs  = attributes(refl.inputs);
+    const auto outputs = attributes(refl.outputs);
+
+    std::vector<binary::SpecConstant> specConstants;
+    specConstants.reserve(refl.specConstants.size());
+    for (const auto& sc : refl.specConstants) {
+        specConstants.push_back({ sc.constantId, strings.add(sc.name), static_cast<uint32_t>(sc.type), sc.bitWidth,
+                                  static_cast<uint32_t>(sc.defaultValue), static_cast<uint32_t>(sc.defaultValue >> 32) });
+    }
+
+    binary::Header h{};
+    h.magic   = binary::Magic;
+    h.version = binary::Version;
+
+    size_t offset = sizeof(binary::Header);
+    auto place = [&](binary::Section& section, size_t count, size_t recordSize) {
+        section.offset = static_cast<uint32_t>(offset);
+        section.count  = static_cast<uint32_t>(count);
+        offset = align4(offset + count * recordSize);
+    };
+    place(h.spirv, shader.spirv.size(), sizeof(uint32_t));
+    place(h.descriptorBindings, bindings.size(), sizeof(binary::DescriptorBinding));
+    place(h.pushConstants, pushConstants.size(), sizeof(binary::PushConstant));
+    place(h.inputs, inputs.size(), sizeof(binary::Attribute));
+    place(h.outputs, outputs.size(), sizeof(binary::Attribute));
+    place(h.specConstants, specConstants.size(), sizeof(binary::SpecConstant));
+    place(h.unusedDescriptorBindings, unusedBindings.size(), sizeof(binary::DescriptorBinding));
+    place(h.strings, strings.bytes().size(), 1);
+    h.size = static_cast<uint32_t>(offset);
+
+    std::vector<uint8_t> blob(h.size, 0);
+    auto copy = [&](const binary::Section& section, const void* src, size_t bytes) {
+        if (bytes)
+            std::memcpy(blob.data() + section.offset, src, bytes);
+    };
+    std::memcpy(blob.data(), &h, sizeof(h));
+    copy(h.spirv, shader.spirv.data(), shader.spirv.size() * sizeof(uint32_t));
+    copy(h.descriptorBindings, bindings.data(), bindings.size() * sizeof(binary::DescriptorBinding));
+    copy(h.pushConstants, pushConstants.data(), pushConstants.size() * sizeof(binary::PushConstant));
+    copy(h.inputs, inputs.data(), inputs.size() * sizeof(binary::Attribute));
+    copy(h.outputs, outputs.data(), outputs.size() * sizeof(binary::Attribute));
+    copy(h.specConstants, specConstants.data(), specConstants.size() * sizeof(binary::SpecConstant));
+    copy(h.unusedDescriptorBindings, unusedBindings.data(), unusedBindings.size() * sizeof(binary::DescriptorBinding));
+    copy(h.strings, strings.bytes().data(), strings.bytes().size());
+    return blob;
+}
+}
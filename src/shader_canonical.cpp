@@ -0,0 +1,520 @@
+/*
+* File: shader_canonical
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_canonical.hpp"
+#include "shader_optimizer.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <spirv-tools/libspirv.h>
+
+namespace shaderpipe {
+
+// Only the opcodes the layout depends on, their values are fixed by the specification.
+namespace op {
+    static constexpr uint32_t String               = 7;
+    static constexpr uint32_t Extension            = 10;
+    static constexpr uint32_t ExtInstImport        = 11;
+    static constexpr uint32_t MemoryModel          = 14;
+    static constexpr uint32_t EntryPoint           = 15;
+    static constexpr uint32_t ExecutionMode        = 16;
+    static constexpr uint32_t Capability           = 17;
+    static constexpr uint32_t TypeForwardPointer   = 39;
+    static constexpr uint32_t Function             = 54;
+    static constexpr uint32_t FunctionEnd          = 56;
+    static constexpr uint32_t FunctionCall         = 57;
+    static constexpr uint32_t Decorate             = 71;
+    static constexpr uint32_t MemberDecorate       = 72;
+    static constexpr uint32_t DecorationGroup      = 73;
+    static constexpr uint32_t GroupDecorate        = 74;
+    static constexpr uint32_t GroupMemberDecorate  = 75;
+    static constexpr uint32_t Label                = 248;
+    static constexpr uint32_t ExecutionModeId      = 331;
+    static constexpr uint32_t DecorateId           = 332;
+    static constexpr uint32_t DecorateString       = 5632;
+    static constexpr uint32_t MemberDecorateString = 5633;
+}
+
+namespace {
+
+struct Instruction {
+    uint32_t opcode;
+    uint32_t resultId;
+    std::vector<uint32_t> words;
+    std::vector<uint16_t> ids; // indices into words of every id operand, result and result type included
+};
+
+struct Function {
+    uint32_t id;
+    size_t begin, end; // range in Module::functionCode
+    bool declaration;  // no body
+};
+
+struct Module {
+    uint32_t version = 0;
+    std::vector<Instruction> preamble;    // capabilities, extensions, imports, memory model, entry points, modes
+    std::vector<Instruction> debug;       // whatever stripping left in the debug section
+    std::vector<Instruction> annotations;
+    std::vector<Instruction> globals;     // types, constants, global variables
+    std::vector<Instruction> functionCode;
+    std::vector<Function> functions;
+};
+
+bool is_annotation(uint32_t opcode) {
+    switch (opcode) {
+    case op::Decorate: case op::MemberDecorate: case op::DecorationGroup: case op::GroupDecorate:
+    case op::GroupMemberDecorate: case op::DecorateId: case op::DecorateString: case op::MemberDecorateString:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_preamble(uint32_t opcode) {
+    switch (opcode) {
+    case op::Capability: case op::Extension: case op::ExtInstImport: case op::MemoryModel:
+    case op::EntryPoint: case op::ExecutionMode: case op::ExecutionModeId:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool is_id_operand(spv_operand_type_t type) {
+    switch (type) {
+    case SPV_OPERAND_TYPE_ID:
+    case SPV_OPERAND_TYPE_TYPE_ID:
+    case SPV_OPERAND_TYPE_RESULT_ID:
+    case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
+    case SPV_OPERAND_TYPE_SCOPE_ID:
+    case SPV_OPERAND_TYPE_OPTIONAL_ID:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Module parse_module(std::span<const uint32_t> words) {
+    struct Parser {
+        Module module;
+        bool inFunction = false;
+    } parser;
+
+    auto onHeader = [](void* user, spv_endianness_t, uint32_t, uint32_t version, uint32_t, uint32_t, uint32_t) {
+        static_cast<Parser*>(user)->module.version = version;
+        return SPV_SUCCESS;
+    };
+    auto onInstruction = [](void* user, const spv_parsed_instruction_t* parsed) {
+        auto& p = *static_cast<Parser*>(user);
+        Instruction inst{ parsed->opcode, parsed->result_id, { parsed->words, parsed->words + parsed->num_words }, {} };
+        for (uint16_t i = 0; i < parsed->num_operands; ++i) {
+            if (is_id_operand(parsed->operands[i].type))
+                inst.ids.push_back(parsed->operands[i].offset);
+        }
+
+        auto& m = p.module;
+        if (inst.opcode == op::Function) {
+            p.inFunction = true;
+            m.functions.push_back({ inst.resultId, m.functionCode.size(), 0, true });
+        }
+        if (p.inFunction) {
+            if (inst.opcode == op::Label)
+                m.functions.back().declaration = false;
+            const bool end = inst.opcode == op::FunctionEnd;
+            m.functionCode.push_back(std::move(inst));
+            if (end) {
+                m.functions.back().end = m.functionCode.size();
+                p.inFunction = false;
+            }
+        } else if (is_preamble(inst.opcode)) {
+            m.preamble.push_back(std::move(inst));
+        } else if (is_annotation(inst.opcode)) {
+            m.annotations.push_back(std::move(inst));
+        } else if (m.annotations.empty() && m.globals.empty() && inst.opcode == op::String) {
+            m.debug.push_back(std::move(inst));
+        } else if (m.annotations.empty() && m.globals.empty() && inst.resultId == 0 && inst.opcode != op::TypeForwardPointer) {
+            m.debug.push_back(std::move(inst)); // source / names, normally stripped already
+        } else {
+            m.globals.push_back(std::move(inst));
+        }
+        return SPV_SUCCESS;
+    };
+
+    spv_context context = spvContextCreate(SPV_ENV_UNIVERSAL_1_6);
+    spv_diagnostic diagnostic = nullptr;
+    const spv_result_t result = spvBinaryParse(context, &parser, words.data(), words.size(), onHeader, onInstruction, &diagnostic);
+    std::string error;
+    if (result != SPV_SUCCESS)
+        error = diagnostic && diagnostic->error ? diagnostic->error : "unknown error";
+    spvDiagnosticDestroy(diagnostic);
+    spvContextDestroy(context);
+
+    if (result != SPV_SUCCESS)
+        throw std::runtime_error("Could not parse SPIR-V for canonicalization: " + error);
+    if (parser.inFunction)
+        throw std::runtime_error("Could not parse SPIR-V for canonicalization: unterminated function.");
+    return std::move(parser.module);
+}
+
+// Literal words of an entry point, the execution model and the name, which do not depend on numbering.
+std::vector<uint32_t> entry_point_key(const Instruction& inst) {
+    const size_t interfaceBegin = inst.ids.size() > 1 ? inst.ids[1] : inst.words.size();
+    std::vector<uint32_t> key{ inst.words[1] };
+    key.insert(key.end(), inst.words.begin() + 3, inst.words.begin() + interfaceBegin);
+    return key;
+}
+
+class Renumberer {
+public:
+    explicit Renumberer(const Module& module) {
+        for (size_t i = 0; i < module.globals.size(); ++i) {
+            if (module.globals[i].resultId)
+                globals[module.globals[i].resultId] = &module.globals[i];
+        }
+    }
+
+    // Ids a global definition refers to are numbered before the definition itself, so sorting the globals by
+    // their new id keeps every definition ahead of its uses.
+    void assign(uint32_t id) {
+        if (mapping.count(id))
+            return;
+        if (auto it = globals.find(id); it != globals.end()) {
+            if (!visiting.insert(id).second)
+                return; // only forward pointers close a cycle
+            for (uint16_t index : it->second->ids) {
+                if (it->second->words[index] != id)
+                    assign(it->second->words[index]);
+            }
+            visiting.erase(id);
+            if (mapping.count(id))
+                return;
+        }
+        mapping[id] = next++;
+    }
+
+    void assign_all(const Instruction& inst) {
+        for (uint16_t index : inst.ids)
+            assign(inst.words[index]);
+    }
+
+    Instruction remap(Instruction inst) const {
+        for (uint16_t index : inst.ids)
+            inst.words[index] = mapping.at(inst.words[index]);
+        if (inst.resultId)
+            inst.resultId = mapping.at(inst.resultId);
+        return inst;
+    }
+
+    uint32_t bound() const { return next; }
+
+private:
+    std::unordered_map<uint32_t, const Instruction*> globals;
+    std::unordered_map<uint32_t, uint32_t> mapping;
+    std::unordered_set<uint32_t> visiting;
+    uint32_t next = 1;
+};
+
+bool words_less(const Instruction& a, const Instruction& b) {
+    return std::tie(a.opcode, a.words) < std::tie(b.opcode, b.words);
+}
+
+void append(std::vector<uint32_t>& out, const Instruction& inst) {
+    out.insert(out.end(), inst.words.begin(), inst.words.end());
+}
+}
+
+std::vector<uint32_t> canonicalize_spirv(std::span<const uint32_t> source) {
+    const auto stripped = compact_spirv(source, true, false);
+    Module module = parse_module(stripped);
+
+    std::vector<const Instruction*> capabilities, extensions, imports, entryPoints, modes;
+    const Instruction* memoryModel = nullptr;
+    for (const auto& inst : module.preamble) {
+        switch (inst.opcode) {
+        case op::Capability:    capabilities.push_back(&inst); break;
+        case op::Extension:     extensions.push_back(&inst); break;
+        case op::ExtInstImport: imports.push_back(&inst); break;
+        case op::MemoryModel:   memoryModel = &inst; break;
+        case op::EntryPoint:    entryPoints.push_back(&inst); break;
+        default:                modes.push_back(&inst); break;
+        }
+    }
+
+    // Imports by name and entry points by model and name, neither depends on the numbering.
+    std::stable_sort(imports.begin(), imports.end(), [](const Instruction* a, const Instruction* b) {
+        return std::lexicographical_compare(a->words.begin() + 2, a->words.end(), b->words.begin() + 2, b->words.end());
+    });
+    std::stable_sort(entryPoints.begin(), entryPoints.end(), [](const Instruction* a, const Instruction* b) {
+        return entry_point_key(*a) < entry_point_key(*b);
+    });
+
+    // Functions: declarations first as the layout requires, then the call graph depth first from every entry
+    // point, then whatever nothing reaches in the order it came in.
+    std::unordered_map<uint32_t, size_t> functionIndex;
+    for (size_t i = 0; i < module.functions.size(); ++i)
+        functionIndex[module.functions[i].id] = i;
+
+    std::vector<size_t> functionOrder;
+    std::vector<bool> placed(module.functions.size(), false);
+    for (size_t i = 0; i < module.functions.size(); ++i) {
+        if (module.functions[i].declaration) {
+            functionOrder.push_back(i);
+            placed[i] = true;
+        }
+    }
+    auto visit = [&](size_t root) {
+        std::vector<size_t> stack{ root };
+        while (!stack.empty()) {
+            const size_t f = stack.back();
+            stack.pop_back();
+            if (placed[f])
+                continue;
+            placed[f] = true;
+            functionOrder.push_back(f);
+
+            std::vector<size_t> callees;
+            const auto& fn = module.functions[f];
+            for (size_t i = fn.begin; i < fn.end; ++i) {
+                const auto& inst = module.functionCode[i];
+                if (inst.opcode != op::FunctionCall || inst.words.size() < 4)
+                    continue;
+                if (auto it = functionIndex.find(inst.words[3]); it != functionIndex.end() && !placed[it->second])
+                    callees.push_back(it->second);
+            }
+            // Reversed so the first call is visited first.
+            stack.insert(stack.end(), callees.rbegin(), callees.rend());
+        }
+    };
+    for (const auto* entry : entryPoints) {
+        if (auto it = functionIndex.find(entry->words[2]); it != functionIndex.end())
+            visit(it->second);
+    }
+    for (size_t i = 0; i < module.functions.size(); ++i)
+        visit(i);
+
+    // Number everything in the order it is first needed.
+    Renumberer ids(module);
+    for (const auto* inst : imports)
+        ids.assign_all(*inst);
+    for (const auto* inst : entryPoints)
+        ids.assign(inst->words[2]);
+    for (const auto* inst : modes)
+        ids.assign_all(*inst);
+    for (size_t f : functionOrder) {
+        for (size_t i = module.functions[f].begin; i < module.functions[f].end; ++i)
+            ids.assign_all(module.functionCode[i]);
+    }
+    // Interface variables nothing reads, only listed by pre 1.4 modules.
+    for (const auto* inst : entryPoints)
+        ids.assign_all(*inst);
+    for (const auto& inst : module.annotations)
+        ids.assign_all(inst);
+    for (const auto& inst : module.globals)
+        ids.assign_all(inst);
+    for (const auto& inst : module.debug)
+        ids.assign_all(inst);
+    if (memoryModel)
+        ids.assign_all(*memoryModel);
+
+    // Emit in the logical layout.
+    std::vector<uint32_t> out{ stripped[0], module.version, 0, ids.bound(), 0 };
+
+    auto emit_sorted = [&](const std::vector<const Instruction*>& insts) {
+        std::vector<Instruction> remapped;
+        remapped.reserve(insts.size());
+        for (const auto* inst : insts)
+            remapped.push_back(ids.remap(*inst));
+        std::sort(remapped.begin(), remapped.end(), words_less);
+        for (const auto& inst : remapped)
+            append(out, inst);
+    };
+
+    emit_sorted(capabilities);
+    emit_sorted(extensions);
+    for (const auto* inst : imports)
+        append(out, ids.remap(*inst));
+    if (memoryModel)
+        append(out, ids.remap(*memoryModel));
+    for (const auto* entry : entryPoints) {
+        auto inst = ids.remap(*entry);
+        if (entry->ids.size() > 1) {
+            const size_t interfaceBegin = entry->ids[1];
+            std::sort(inst.words.begin() + interfaceBegin, inst.words.end());
+        }
+        append(out, inst);
+    }
+    emit_sorted(modes);
+
+    for (const auto& inst : module.debug)
+        append(out, ids.remap(inst));
+
+    // Decoration groups have to stay ahead of the instructions that apply them, keep their modules as they are.
+    const bool hasGroups = std::any_of(module.annotations.begin(), module.annotations.end(),
+                                       [](const Instruction& inst) { return inst.opcode == op::DecorationGroup; });
+    {
+        std::vector<Instruction> annotations;
+        annotations.reserve(module.annotations.size());
+        for (const auto& inst : module.annotations)
+            annotations.push_back(ids.remap(inst));
+        if (!hasGroups)
+            std::sort(annotations.begin(), annotations.end(), words_less);
+        for (const auto& inst : annotations)
+            append(out, inst);
+    }
+
+    // Forward pointers are the one case where definition order can not follow from numbering.
+    const bool keepGlobalOrder = std::any_of(module.globals.begin(), module.globals.end(),
+                                             [](const Instruction& inst) { return inst.resultId == 0; });
+    {
+        std::vector<Instruction> globals;
+        globals.reserve(module.globals.size());
+        for (const auto& inst : module.globals)
+            globals.push_back(ids.remap(inst));
+        if (!keepGlobalOrder) {
+            std::sort(globals.begin(), globals.end(),
+                      [](const Instruction& a, const Instruction& b) { return a.resultId < b.resultId; });
+        }
+        for (const auto& inst : globals)
+            append(out, inst);
+    }
+
+    for (size_t f : functionOrder) {
+        for (size_t i = module.functions[f].begin; i < module.functions[f].end; ++i)
+            append(out, ids.remap(module.functionCode[i]));
+    }
+    return out;
+}
+
+static void hash_binding(Hasher& h, const DescriptorBindingInfo& b) {
+    h.update_value(b.set);
+    h.update_value(b.binding);
+    h.update_value(static_cast<uint32_t>(b.type));
+    h.update_value(b.count);
+    h.update_value(static_cast<uint32_t>(b.stageFlags));
+}
+
+static void hash_attribute(Hasher& h, const InputAttributeInfo& a) {
+    h.update_value(a.location);
+    h.update_value(a.vecSize);
+    h.update_value(a.bitWidth);
+    h.update_value(static_cast<uint32_t>(a.baseType));
+    h.update_value(a.columns);
+    h.update_value(a.arraySize);
+}
+
+template<typename T, typename Less, typename Fn>
+static void hash_sorted(Hasher& h, const std::vector<T>& items, Less less, Fn hash_item) {
+    std::vector<const T*> sorted;
+    sorted.reserve(items.size());
+    for (const auto& item : items)
+        sorted.push_back(&item);
+    std::sort(sorted.begin(), sorted.end(), [&](const T* a, const T* b) { return less(*a, *b); });
+
+    h.update_value(static_cast<uint64_t>(sorted.size()));
+    for (const auto* item : sorted)
+        hash_item(h, *item);
+}
+
+ShaderHash hash_reflection(const ShaderReflection& reflection) {
+    auto bindingLess = [](const DescriptorBindingInfo& a, const DescriptorBindingInfo& b) {
+        return std::tie(a.set, a.binding) < std::tie(b.set, b.binding);
+    };
+    auto attributeLess = [](const InputAttributeInfo& a, const InputAttributeInfo& b) { return a.location < b.location; };
+
+    Hasher h;
+    hash_sorted(h, reflection.descriptorBindings, bindingLess, hash_binding);
+    hash_sorted(h, reflection.pushConstants,
+                [](const PushConstantInfo& a, const PushConstantInfo& b) { return std::tie(a.offset, a.size) < std::tie(b.offset, b.size); },
+                [](Hasher& hasher, const PushConstantInfo& p) {
+                    hasher.update_value(p.offset);
+                    hasher.update_value(p.size);
+                    hasher.update_value(static_cast<uint32_t>(p.stageFlags));
+                });
+    hash_sorted(h, reflection.inputs, attributeLess, hash_attribute);
+    hash_sorted(h, reflection.outputs, attributeLess, hash_attribute);
+    hash_sorted(h, reflection.specConstants,
+                [](const SpecConstantInfo& a, const SpecConstantInfo& b) { return a.constantId < b.constantId; },
+                [](Hasher& hasher, const SpecConstantInfo& s) {
+                    hasher.update_value(s.constantId);
+                    hasher.update_value(static_cast<uint32_t>(s.type));
+                    hasher.update_value(s.bitWidth);
+                    hasher.update_value(s.defaultValue);
+                });
+    hash_sorted(h, reflection.unusedDescriptorBindings, bindingLess, hash_binding);
+    return h.finish();
+}
+
+ShaderHash canonical_shader_hash(const CompiledShader& shader) {
+    const auto canonical = canonicalize_spirv(shader.spirv);
+    const auto reflection = hash_reflection(shader.reflection);
+
+    Hasher h;
+    h.update("shaderpipe-canonical-1");
+    h.update(canonical.data(), canonical.size() * sizeof(uint32_t));
+    h.update_value(reflection);
+    return h.finish();
+}
+
+struct ModuleRegistry::Impl {
+    mutable std::mutex mutex;
+    std::unordered_map<ShaderHash, std::shared_ptr<const CompiledShader>> modules;
+    uint64_t duplicates = 0;
+};
+
+ModuleRegistry::ModuleRegistry() : impl(std::make_unique<Impl>()) {}
+ModuleRegistry::~ModuleRegistry() = default;
+
+RegisteredModule ModuleRegistry::add(CompiledShader shader) {
+    // Hashed outside the lock, it is the expensive part.
+    const auto hash = canonical_shader_hash(shader);
+
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    auto [it, inserted] = impl->modules.try_emplace(hash);
+    if (inserted)
+        it->second = std::make_shared<const CompiledShader>(std::move(shader));
+    else
+        ++impl->duplicates;
+    return { hash, it->second, inserted };
+}
+
+std::shared_ptr<const CompiledShader> ModuleRegistry::find(const ShaderHash& hash) const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    auto it = impl->modules.find(hash);
+    return it == impl->modules.end() ? nullptr : it->second;
+}
+
+bool ModuleRegistry::remove(const ShaderHash& hash) {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->modules.erase(hash) > 0;
+}
+
+void ModuleRegistry::clear() {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->modules.clear();
+    impl->duplicates = 0;
+}
+
+size_t ModuleRegistry::size() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->modules.size();
+}
+
+uint64_t ModuleRegistry::duplicates() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->duplicates;
+}
+}
@@ -0,0 +1,354 @@
+/*
+* File: shader_compiler
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_compiler.hpp"
+#include "shader_pipe_internal.hpp"
+#include "shader_thread_pool.hpp"
+#include "shader_disk_cache.hpp"
+#include "shader_includer.hpp"
+#include "shader_trace_internal.hpp"
+
+#include <stdexcept>
+
+#include <glslang/Public/ShaderLang.h>
+#include <SPIRV/GlslangToSpv.h>
+
+namespace shaderpipe {
+
+namespace {
+// glslang reference counts its clients and frees the shared built-in symbol tables when the count hits zero.
+// Holding one reference until exit keeps them alive no matter how many Compilers come and go.
+struct GlslangProcess {
+    GlslangProcess() { glslang::InitializeProcess(); }
+    ~GlslangProcess() { glslang::FinalizeProcess(); }
+};
+
+void acquire_glslang_process() {
+    static GlslangProcess process; // thread safe init
+}
+}
+
+// Turns on #include handling. Only injected when the caller configured includes, so plain sources compile exactly as before.
+static const char* IncludePreamble = "#extension GL_GOOGLE_include_directive : require\n";
+
+static std::string build_preamble(const CompileOptions& options) {
+    std::string preamble;
+    if (options.includes_enabled())
+        preamble += IncludePreamble;
+    for (const auto& define : options.defines) {
+        preamble += "#define ";
+        preamble += define.name;
+        if (!define.value.empty()) {
+            preamble += ' ';
+            preamble += define.value;
+        }
+        preamble += '\n';
+    }
+    return preamble;
+}
+
+// Everything glslang needs before parse / preprocess, shared so both see the exact same environment.
+// glslang keeps a pointer to preamble, it has to outlive the shader.
+static void setup_shader(glslang::TShader& shader, const char* const* glslSource, const int* sourceLength, const char* const* sourceName,
+                         const std::string& preamble, std::string_view source, EShLanguage sStage, VKVersion targetVulkanVersion) {
+    shader.setStringsWithLengthsAndNames(glslSource, sourceLength, sourceName, 1);
+    if (!preamble.empty())
+        shader.setPreamble(preamble.c_str());
+
+    uint32_t glslVersion = get_glsl_version(source);
+    const auto vulkanVersion = vk_version_to_glslang(targetVulkanVersion);
+    const auto spvVersion = vk_version_to_spirv_version(targetVulkanVersion);
+
+    shader.setEnvInput(glslang::EShSourceGlsl, sStage, glslang::EShClientVulkan, static_cast<int>(glslVersion));
+    shader.setEnvClient(glslang::EShClientVulkan, vulkanVersion);
+    shader.setEnvTarget(glslang::EShTargetSpv, spvVersion);
+}
+
+static bool cancelled(const CompileOptions& options) {
+    return options.cancelFlag && options.cancelFlag->load(std::memory_order_relaxed);
+}
+
+static StatusCode cancel(DiagnosticBuffer& diagnostics) {
+    diagnostics.set_error(CompileCancelled().what());
+    return StatusCode::CANCELLED;
+}
+
+// The throwing API reports exactly what it always did: glslang's info log, or CompileCancelled.
+[[noreturn]] static void throw_status(StatusCode status, const DiagnosticBuffer& diagnostics) {
+    if (status == StatusCode::CANCELLED)
+        throw CompileCancelled();
+    throw std::runtime_error(std::string(diagnostics.log()));
+}
+
+// Errors in the shader come back as a status with the log in diagnostics rather than as exceptions, while editing
+// they are the common case. Only failures outside glslang (spirv-opt, allocation) still unwind in here.
+static StatusCode preprocess_source(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options,
+                                    std::string& output, std::vector<std::string>* includedFiles, DiagnosticBuffer& diagnostics) {
+    const char* glslSource = source.data(); // lengths are passed explicitly, no terminator needed
+    const int sourceLength = static_cast<int>(source.size());
+    const std::string sourceName = options.sourcePath.string();
+    const char* sourceNamePtr = sourceName.c_str();
+
+    auto sStage = shader_stage_to_glslang(stage);
+    const std::string preamble = build_preamble(options);
+    glslang::TShader shader(sStage);
+    setup_shader(shader, &glslSource, &sourceLength, &sourceNamePtr, preamble, source, sStage, targetVulkanVersion);
+
+    FileIncluder includer(options.includeDirectories);
+    {
+        TraceScope scope(TracePhase::PREPROCESS);
+        if (!shader.preprocess(&DefaultTBuiltInResource, 450, ENoProfile, false, false, EShMsgDefault, &output, includer)) {
+            diagnostics.set_log(shader.getInfoLog());
+            return StatusCode::PREPROCESS_FAILED;
+        }
+    }
+
+    if (includedFiles)
+        *includedFiles = includer.included_files();
+    return StatusCode::OK;
+}
+
+static StatusCode compile_spirv(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options,
+                                std::vector<uint32_t>& spirv, DiagnosticBuffer& diagnostics) {
+    const char* glslSource = source.data(); // lengths are passed explicitly, no terminator needed
+    const int sourceLength = static_cast<int>(source.size());
+    const std::string sourceName = options.sourcePath.string();
+    const char* sourceNamePtr = sourceName.c_str();
+
+    auto sStage = shader_stage_to_glslang(stage);
+    const std::string preamble = build_preamble(options);
+    glslang::TShader shader(sStage);
+    setup_shader(shader, &glslSource, &sourceLength, &sourceNamePtr, preamble, source, sStage, targetVulkanVersion);
+
+    if (cancelled(options))
+        return cancel(diagnostics);
+    FileIncluder includer(options.includeDirectories);
+    {
+        TraceScope scope(TracePhase::PARSE);
+        if (!shader.parse(&DefaultTBuiltInResource, 450, false, EShMsgDefault, includer)) {
+            diagnostics.set_log(shader.getInfoLog());
+            return StatusCode::COMPILE_FAILED;
+        }
+    }
+
+    if (cancelled(options))
+        return cancel(diagnostics);
+    glslang::TProgram program;
+    program.addShader(&shader);
+
+    {
+        TraceScope scope(TracePhase::LINK);
+        if (!program.link(EShMsgDefault)) {
+            diagnostics.set_log(program.getInfoLog());
+            return StatusCode::LINK_FAILED;
+        }
+    }
+
+    if (cancelled(options))
+        return cancel(diagnostics);
+    {
+        TraceScope scope(TracePhase::SPIRV_GEN);
+        glslang::GlslangToSpv(*program.getIntermediate(sStage), spirv);
+    }
+
+    if (options.optimization.enabled()) {
+        if (cancelled(options))
+            return cancel(diagnostics);
+        TraceScope scope(TracePhase::OPTIMIZE);
+        try {
+            spirv = optimize_spirv(spirv, targetVulkanVersion, options.optimization);
+        } catch (const std::exception& e) {
+            diagnostics.set_error(e.what());
+            return StatusCode::OPTIMIZE_FAILED;
+        }
+    }
+
+    return StatusCode::OK;
+}
+
+static StatusCode compile_with_reflection(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                          const CompileOptions& options, CompiledShader& result, DiagnosticBuffer& diagnostics) {
+    CompileTrace trace("glsl_to_spirv_with_reflection", options.sourcePath, stage);
+    if (cancelled(options))
+        return cancel(diagnostics);
+
+    const auto& diskCache = compiler.get_settings().diskCache;
+    ShaderHash key;
+    if (diskCache) {
+        std::string preprocessed;
+        if (auto status = preprocess_source(source, stage, targetVulkanVersion, options, preprocessed, nullptr, diagnostics); status != StatusCode::OK)
+            return status;
+
+        std::optional<CompiledShader> cached;
+        {
+            TraceScope scope(TracePhase::CACHE_LOOKUP);
+            key = compiler.cache_key(preprocessed, stage, targetVulkanVersion, options);
+            cached = diskCache->load(key);
+        }
+        trace.set_cache(cached ? CacheResult::HIT : CacheResult::MISS);
+        if (cached) {
+            result = std::move(*cached);
+            trace.set_spirv_words(result.spirv.size());
+            trace.succeeded();
+            return StatusCode::OK;
+        }
+    }
+
+    if (auto status = compile_spirv(source, stage, targetVulkanVersion, options, result.spirv, diagnostics); status != StatusCode::OK)
+        return status;
+    if (cancelled(options))
+        return cancel(diagnostics);
+    try {
+        result.reflection = reflect_spirv(result.spirv, options.reflection);
+    } catch (const std::exception& e) {
+        diagnostics.set_error(e.what());
+        return StatusCode::INVALID_SPIRV;
+    }
+
+    if (diskCache) {
+        TraceScope scope(TracePhase::CACHE_STORE);
+        diskCache->store(key, result);
+    }
+
+    trace.set_spirv_words(result.spirv.size());
+    trace.succeeded();
+    return StatusCode::OK;
+}
+
+Compiler::Compiler(CompilerSettings settings) : settings(std::move(settings)) {
+    acquire_glslang_process();
+}
+
+Compiler::~Compiler() = default;
+
+std::string Compiler::preprocess(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                 const CompileOptions& options, std::vector<std::string>* includedFiles) const {
+    CompileTrace trace("preprocess", options.sourcePath, stage);
+    std::string output;
+    DiagnosticBuffer diagnostics;
+    if (auto status = preprocess_source(source, stage, targetVulkanVersion, options, output, includedFiles, diagnostics); status != StatusCode::OK)
+        throw_status(status, diagnostics);
+    trace.succeeded();
+    return output;
+}
+
+void hash_compile_options(Hasher& h, const CompileOptions& options) {
+    const auto& opt = options.optimization;
+    h.update_value(opt.level);
+    h.update_value(static_cast<uint64_t>(opt.customPasses.size()));
+    for (const auto& pass : opt.customPasses)
+        h.update(pass);
+    h.update_value(static_cast<uint8_t>(opt.validateInput));
+    h.update_value(static_cast<uint8_t>(opt.validateOutput));
+
+    h.update(options.sourcePath.string());
+    h.update_value(static_cast<uint64_t>(options.includeDirectories.size()));
+    for (const auto& dir : options.includeDirectories)
+        h.update(dir.string());
+
+    h.update_value(static_cast<uint64_t>(options.defines.size()));
+    for (const auto& define : options.defines) {
+        h.update(define.name);
+        h.update(define.value);
+    }
+
+    h.update_value(static_cast<uint8_t>(options.reflection.activeOnly));
+}
+
+ShaderHash Compiler::cache_key(std::string_view preprocessedSource, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options) const {
+    Hasher h;
+
+    // Anything that can change the output without changing the source has to be part of the key.
+    h.update(std::string_view("shaderpipe " SHADERPIPE_VERSION));
+    const auto glslangVersion = glslang::GetVersion();
+    h.update_value(glslangVersion.major);
+    h.update_value(glslangVersion.minor);
+    h.update_value(glslangVersion.patch);
+    h.update(std::string_view(glslangVersion.flavor ? glslangVersion.flavor : ""));
+    h.update(&DefaultTBuiltInResource, sizeof(DefaultTBuiltInResource));
+
+    h.update_value(stage);
+    h.update_value(targetVulkanVersion);
+    hash_compile_options(h, options);
+    h.update(preprocessedSource);
+
+    return h.finish();
+}
+
+std::vector<uint32_t> Compiler::glsl_to_spirv(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options) const {
+    // The disk cache stores SPIR-V and reflection together, go through the combined path so a hit skips glslang.
+    if (settings.diskCache)
+        return glsl_to_spirv_with_reflection(source, stage, targetVulkanVersion, options).spirv;
+
+    CompileTrace trace("glsl_to_spirv", options.sourcePath, stage);
+    std::vector<uint32_t> spirv;
+    DiagnosticBuffer diagnostics;
+    if (auto status = compile_spirv(source, stage, targetVulkanVersion, options, spirv, diagnostics); status != StatusCode::OK)
+        throw_status(status, diagnostics);
+    trace.set_spirv_words(spirv.size());
+    trace.succeeded();
+    return spirv;
+}
+
+CompiledShader Compiler::glsl_to_spirv_with_reflection(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options) const {
+    CompiledShader result;
+    DiagnosticBuffer diagnostics;
+    if (auto status = compile_with_reflection(*this, source, stage, targetVulkanVersion, options, result, diagnostics); status != StatusCode::OK)
+        throw_status(status, diagnostics);
+    return result;
+}
+
+Result<CompiledShader> Compiler::try_glsl_to_spirv_with_reflection(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                                   DiagnosticBuffer& diagnostics, const CompileOptions& options) const noexcept {
+    try {
+        CompiledShader result;
+        if (auto status = compile_with_reflection(*this, source, stage, targetVulkanVersion, options, result, diagnostics); status != StatusCode::OK)
+            return status;
+        diagnostics.clear();
+        return result;
+    } catch (const std::exception& e) {
+        diagnostics.set_error(e.what());
+        return StatusCode::INTERNAL_ERROR;
+    } catch (...) {
+        diagnostics.set_error("Unknown error.");
+        return StatusCode::INTERNAL_ERROR;
+    }
+}
+
+std::vector<BatchResult> Compiler::compile_batch(std::span<const CompileJob> jobs, ThreadPool& pool) const {
+    std::vector<BatchResult> results(jobs.size());
+
+    pool.parallel_for(jobs.size(), [&](size_t i) {
+        const auto& job = jobs[i];
+        auto& result = results[i];
+        DiagnosticBuffer diagnostics;
+        auto compiled = try_glsl_to_spirv_with_reflection(job.source, job.stage, job.targetVulkanVersion, diagnostics, job.options);
+        if (compiled) {
+            result.shader = std::move(compiled).value();
+            result.success = true;
+        } else {
+            result.error = diagnostics.log();
+        }
+    });
+
+    return results;
+}
+
+std::vector<BatchResult> Compiler::compile_batch(std::span<const CompileJob> jobs) const {
+    return compile_batch(jobs, default_thread_pool());
+}
+
+Compiler& default_compiler() {
+    static Compiler compiler;
+    return compiler;
+}
+}
@@ -0,0 +1,642 @@
+/*
+* File: shader_daemon
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_daemon.hpp"
+#include "shader_binary.hpp"
+#include "shader_memory_cache.hpp"
+#include "shader_thread_pool.hpp"
+
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define SHADERPIPE_HAS_UNIX_SOCKETS 1
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/time.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+static_assert(std::endian::native == std::endian::little, "The daemon protocol is little endian, same as the shader binary format.");
+
+// Every message is a u32 byte count followed by the payload.
+//   request:  magic, version, request id, kind, then the kind specific fields
+//   response: request id, status, then a shader binary (OK) or an error string
+// Strings are a u32 length followed by the bytes, all integers are little endian u32.
+namespace {
+constexpr uint32_t ProtocolMagic = 0x4d445053; // "SPDM"
+constexpr uint32_t ProtocolVersion = 4; // bump whenever a request or the shader binary format changes
+constexpr uint32_t MaxFrameBytes = 256u * 1024 * 1024;
+
+enum class RequestKind : uint32_t {
+    COMPILE = 1, // stage, vulkan version, CompileOptions, source
+    REFLECT = 2, // SPIR-V word count, words
+};
+
+enum class ResponseStatus : uint32_t {
+    OK = 0,
+    ERROR = 1,             // the compile failed, the message is meant for the user
+    PROTOCOL_MISMATCH = 2, // client and daemon come from different builds, the client compiles itself
+};
+
+class Writer {
+public:
+    void u32(uint32_t v) { append(&v, sizeof(v)); }
+    void str(std::string_view s) {
+        u32(static_cast<uint32_t>(s.size()));
+        append(s.data(), s.size());
+    }
+    void append(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+
+    std::vector<uint8_t> bytes;
+};
+
+class Reader {
+public:
+    explicit Reader(std::span<const uint8_t> data) : p(data.data()), end(data.data() + data.size()) {}
+
+    uint32_t u32() {
+        uint32_t v = 0;
+        if (!take(&v, sizeof(v)))
+            ok = false;
+        return v;
+    }
+    std::string str() {
+        const uint32_t length = u32();
+        if (!ok || static_cast<size_t>(end - p) < length) {
+            ok = false;
+            return {};
+        }
+        std::string s(reinterpret_cast<const char*>(p), length);
+        p += length;
+        return s;
+    }
+    bool take(void* out, size_t size) {
+        if (static_cast<size_t>(end - p) < size)
+            return false;
+        std::memcpy(out, p, size);
+        p += size;
+        return true;
+    }
+    bool done() const { return ok && p == end; }
+
+    bool ok = true;
+
+private:
+    const uint8_t* p;
+    const uint8_t* end;
+};
+
+void write_options(Writer& w, const CompileOptions& options) {
+    const auto& opt = options.optimization;
+    w.u32(static_cast<uint32_t>(opt.level));
+    w.u32(opt.validateInput);
+    w.u32(opt.validateOutput);
+    w.u32(static_cast<uint32_t>(opt.customPasses.size()));
+    for (const auto& pass : opt.customPasses)
+        w.str(pass);
+
+    w.str(options.sourcePath.empty() ? std::string() : fs::absolute(options.sourcePath).string());
+    w.u32(static_cast<uint32_t>(options.includeDirectories.size()));
+    for (const auto& dir : options.includeDirectories)
+        w.str(fs::absolute(dir).string());
+
+    w.u32(static_cast<uint32_t>(options.defines.size()));
+    for (const auto& define : options.defines) {
+        w.str(define.name);
+        w.str(define.value);
+    }
+
+    w.u32(options.reflection.activeOnly);
+}
+
+CompileOptions read_options(Reader& r) {
+    CompileOptions options;
+    auto& opt = options.optimization;
+    const uint32_t level = r.u32();
+    opt.level = level <= static_cast<uint32_t>(OptimizationLevel::SIZE) ? static_cast<OptimizationLevel>(level) : (r.ok = false, OptimizationLevel::NONE);
+    opt.validateInput = r.u32() != 0;
+    opt.validateOutput = r.u32() != 0;
+    for (uint32_t i = 0, n = r.u32(); r.ok && i < n; ++i)
+        opt.customPasses.push_back(r.str());
+
+    options.sourcePath = r.str();
+    for (uint32_t i = 0, n = r.u32(); r.ok && i < n; ++i)
+        options.includeDirectories.emplace_back(r.str());
+
+    for (uint32_t i = 0, n = r.u32(); r.ok && i < n; ++i) {
+        auto name = r.str();
+        options.defines.push_back({ std::move(name), r.str() });
+    }
+
+    options.reflection.activeOnly = r.u32() != 0;
+    return options;
+}
+
+std::vector<uint8_t> response(uint32_t requestId, ResponseStatus status, std::span<const uint8_t> body = {}) {
+    Writer w;
+    w.u32(requestId);
+    w.u32(static_cast<uint32_t>(status));
+    w.append(body.data(), body.size());
+    return std::move(w.bytes);
+}
+
+std::vector<uint8_t> error_response(uint32_t requestId, ResponseStatus status, std::string_view message) {
+    Writer w;
+    w.str(message);
+    return response(requestId, status, w.bytes);
+}
+
+#ifdef SHADERPIPE_HAS_UNIX_SOCKETS
+
+#ifdef MSG_NOSIGNAL
+constexpr int SendFlags = MSG_NOSIGNAL; // a client that went away must not kill the daemon with SIGPIPE
+#else
+constexpr int SendFlags = 0;
+#endif
+
+// A daemon that stops answering must not stall the build, the client gives up and compiles in-process.
+// The daemon gives up on a client that stops reading after the same time, instead of pinning a pool thread.
+constexpr int ClientTimeoutSeconds = 60;
+
+void set_cloexec(int fd) {
+    fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+// Accepted sockets inherit O_NONBLOCK from the listening one on macOS and the BSDs, responses are sent blocking.
+void set_blocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+}
+
+void set_send_timeout(int fd) {
+    const timeval timeout{ ClientTimeoutSeconds, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+bool send_all(int fd, const void* data, size_t size) {
+    const auto* p = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t n = send(fd, p, size, SendFlags);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool recv_all(int fd, void* data, size_t size) {
+    auto* p = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t n = recv(fd, p, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool send_frame(int fd, std::span<const uint8_t> payload) {
+    const auto size = static_cast<uint32_t>(payload.size());
+    return send_all(fd, &size, sizeof(size)) && send_all(fd, payload.data(), payload.size());
+}
+
+bool make_address(const fs::path& path, sockaddr_un& addr) {
+    const auto str = path.string();
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (str.size() >= sizeof(addr.sun_path))
+        return false;
+    std::memcpy(addr.sun_path, str.c_str(), str.size() + 1);
+    return true;
+}
+
+int connect_socket(const fs::path& path) {
+    sockaddr_un addr;
+    if (!make_address(path, addr))
+        return -1;
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    set_cloexec(fd);
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int connect_client(const fs::path& path) {
+    const int fd = connect_socket(path);
+    if (fd >= 0) {
+        const timeval timeout{ ClientTimeoutSeconds, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        set_send_timeout(fd);
+    }
+    return fd;
+}
+
+#endif
+}
+
+fs::path default_daemon_socket_path() {
+    if (const char* env = std::getenv("SHADERPIPE_SOCKET"); env && *env)
+        return env;
+#ifdef SHADERPIPE_HAS_UNIX_SOCKETS
+    const auto name = "shaderpipe-" + std::to_string(getuid()) + ".sock";
+    if (const char* runtime = std::getenv("XDG_RUNTIME_DIR"); runtime && *runtime)
+        return fs::path(runtime) / name;
+#else
+    const std::string name = "shaderpipe.sock";
+#endif
+    std::error_code ec;
+    auto tmp = fs::temp_directory_path(ec);
+    return (ec ? fs::path("/tmp") : tmp) / name;
+}
+
+#ifdef SHADERPIPE_HAS_UNIX_SOCKETS
+
+namespace {
+struct Connection {
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() { close(fd); } // the last in flight response may outlive the poll loop's reference
+
+    const int fd;
+    std::mutex writeMutex;   // responses are written from pool threads, one frame at a time
+    std::vector<uint8_t> inbox; // poll thread only
+};
+}
+
+struct ShaderDaemon::Impl {
+    Impl(const Compiler& compiler, DaemonOptions options)
+        : compiler(compiler), options(std::move(options)), cache(this->options.cacheBytes), pool(this->options.threadCount) {}
+
+    const Compiler& compiler;
+    DaemonOptions options;
+    fs::path socketPath;
+    ShaderCache cache;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+    int listenFd = -1;
+    int wakePipe[2] = { -1, -1 };
+    std::vector<std::shared_ptr<Connection>> connections; // poll thread only
+
+    // Last, so it is torn down first and no task can outlive the cache.
+    ThreadPool pool;
+
+    void run();
+    bool receive(const std::shared_ptr<Connection>& connection);
+    std::vector<uint8_t> handle(std::span<const uint8_t> payload);
+    void close_fds();
+};
+
+std::vector<uint8_t> ShaderDaemon::Impl::handle(std::span<const uint8_t> payload) {
+    Reader r(payload);
+    const uint32_t magic = r.u32();
+    const uint32_t version = r.u32();
+    const uint32_t requestId = r.u32();
+    if (!r.ok || magic != ProtocolMagic || version != ProtocolVersion)
+        return error_response(requestId, ResponseStatus::PROTOCOL_MISMATCH, "Unsupported shaderpipe daemon protocol.");
+
+    try {
+        switch (static_cast<RequestKind>(r.u32())) {
+        case RequestKind::COMPILE: {
+            const uint32_t stage = r.u32();
+            const uint32_t vkVersion = r.u32();
+            const auto compileOptions = read_options(r);
+            const auto source = r.str();
+            if (!r.done() || stage > static_cast<uint32_t>(ShaderStage::MESH) || vkVersion > static_cast<uint32_t>(VKVersion::VK_1_4))
+                break;
+
+            const auto shader = cache.glsl_to_spirv_with_reflection(compiler, source, static_cast<ShaderStage>(stage),
+                                                                    static_cast<VKVersion>(vkVersion), compileOptions);
+            return response(requestId, ResponseStatus::OK, write_shader_binary(*shader));
+        }
+        case RequestKind::REFLECT: {
+            const uint32_t wordCount = r.u32();
+            std::vector<uint32_t> spirv(r.ok ? std::min<size_t>(wordCount, payload.size() / 4) : 0);
+            if (!r.ok || spirv.size() != wordCount || !r.take(spirv.data(), spirv.size() * 4) || !r.done())
+                break;
+
+            CompiledShader shader;
+            shader.reflection = reflect_spirv(spirv);
+            return response(requestId, ResponseStatus::OK, write_shader_binary(shader));
+        }
+        }
+    } catch (const std::exception& e) {
+        return error_response(requestId, ResponseStatus::ERROR, e.what());
+    }
+    return error_response(requestId, ResponseStatus::PROTOCOL_MISMATCH, "Malformed shaderpipe daemon request.");
+}
+
+bool ShaderDaemon::Impl::receive(const std::shared_ptr<Connection>& connection) {
+    bool open = true;
+    uint8_t buffer[64 * 1024];
+    for (;;) {
+        const ssize_t n = recv(connection->fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (n > 0) {
+            connection->inbox.insert(connection->inbox.end(), buffer, buffer + n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR)
+            continue;
+        open = n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        break;
+    }
+
+    // Every complete frame becomes its own task, a client can pipeline requests and gets answers as they finish.
+    auto& inbox = connection->inbox;
+    size_t consumed = 0;
+    while (inbox.size() - consumed >= sizeof(uint32_t)) {
+        uint32_t size;
+        std::memcpy(&size, inbox.data() + consumed, sizeof(size));
+        if (size > MaxFrameBytes)
+            return false;
+        if (inbox.size() - consumed - sizeof(size) < size)
+            break;
+
+        const auto* begin = inbox.data() + consumed + sizeof(size);
+        pool.submit([this, connection, payload = std::vector<uint8_t>(begin, begin + size)] {
+            const auto out = handle(payload);
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            // A frame cut off halfway leaves the stream unusable, hang up so the client sees EOF and falls back.
+            if (!send_frame(connection->fd, out))
+                shutdown(connection->fd, SHUT_RDWR);
+        });
+        consumed += sizeof(size) + size;
+    }
+    inbox.erase(inbox.begin(), inbox.begin() + static_cast<ptrdiff_t>(consumed));
+    return open;
+}
+
+void ShaderDaemon::Impl::run() {
+    std::vector<pollfd> fds;
+    while (running.load()) {
+        fds.clear();
+        fds.push_back({ wakePipe[0], POLLIN, 0 });
+        fds.push_back({ listenFd, POLLIN, 0 });
+        for (const auto& connection : connections)
+            fds.push_back({ connection->fd, POLLIN, 0 });
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[0].revents & POLLIN)
+            break;
+
+        std::vector<std::shared_ptr<Connection>> alive;
+        alive.reserve(connections.size() + 1);
+        for (size_t i = 0; i < connections.size(); ++i) {
+            const bool active = fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR);
+            if (!active || receive(connections[i]))
+                alive.push_back(std::move(connections[i]));
+        }
+        connections = std::move(alive);
+
+        if (fds[1].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(listenFd, nullptr, nullptr)) >= 0) {
+                set_cloexec(fd);
+                set_blocking(fd);
+                set_send_timeout(fd);
+                connections.push_back(std::make_shared<Connection>(fd));
+            }
+        }
+    }
+    connections.clear();
+}
+
+void ShaderDaemon::Impl::close_fds() {
+    for (int* fd : { &listenFd, &wakePipe[0], &wakePipe[1] }) {
+        if (*fd >= 0)
+            close(*fd);
+        *fd = -1;
+    }
+}
+
+ShaderDaemon::ShaderDaemon(const Compiler& compiler, DaemonOptions options)
+    : impl(std::make_unique<Impl>(compiler, std::move(options))) {
+    impl->socketPath = impl->options.socketPath.empty() ? default_daemon_socket_path() : impl->options.socketPath;
+}
+
+ShaderDaemon::~ShaderDaemon() {
+    stop();
+}
+
+void ShaderDaemon::start() {
+    if (impl->running.exchange(true))
+        return;
+
+    const auto fail = [this](const std::string& message) {
+        impl->close_fds();
+        impl->running = false;
+        throw std::runtime_error(message + " (" + impl->socketPath.string() + ")");
+    };
+
+    sockaddr_un addr;
+    if (!make_address(impl->socketPath, addr))
+        fail("Daemon socket path is too long.");
+
+    // A socket file nobody answers on was left behind by a daemon that did not shut down cleanly.
+    if (const int probe = connect_socket(impl->socketPath); probe >= 0) {
+        close(probe);
+        fail("A shaderpipe daemon is already running.");
+    }
+    std::error_code ec;
+    fs::remove(impl->socketPath, ec);
+
+    impl->listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (impl->listenFd < 0)
+        fail(std::string("Could not create the daemon socket: ") + std::strerror(errno));
+    set_cloexec(impl->listenFd);
+
+    // Compiles read files as this user, keep other users out. Through the umask so the socket is never reachable
+    // with looser permissions, a chmod after bind would leave a window.
+    const mode_t previousMask = umask(S_IRWXG | S_IRWXO);
+    const int bound = bind(impl->listenFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    const int bindError = errno;
+    umask(previousMask);
+    if (bound != 0)
+        fail(std::string("Could not bind the daemon socket: ") + std::strerror(bindError));
+    if (listen(impl->listenFd, SOMAXCONN) != 0)
+        fail(std::string("Could not listen on the daemon socket: ") + std::strerror(errno));
+    fcntl(impl->listenFd, F_SETFL, fcntl(impl->listenFd, F_GETFL) | O_NONBLOCK);
+
+    if (pipe(impl->wakePipe) != 0)
+        fail(std::string("Could not create the daemon wake up pipe: ") + std::strerror(errno));
+    set_cloexec(impl->wakePipe[0]);
+    set_cloexec(impl->wakePipe[1]);
+
+    impl->thread = std::thread([this] { impl->run(); });
+}
+
+void ShaderDaemon::stop() {
+    if (!impl->running.exchange(false))
+        return;
+    const char wake = 1;
+    (void)!write(impl->wakePipe[1], &wake, 1);
+    if (impl->thread.joinable())
+        impl->thread.join();
+    impl->close_fds();
+
+    std::error_code ec;
+    fs::remove(impl->socketPath, ec);
+}
+
+#else
+
+struct ShaderDaemon::Impl {
+    fs::path socketPath;
+};
+
+ShaderDaemon::ShaderDaemon(const Compiler&, DaemonOptions options) : impl(std::make_unique<Impl>()) {
+    impl->socketPath = options.socketPath.empty() ? default_daemon_socket_path() : options.socketPath;
+}
+
+ShaderDaemon::~ShaderDaemon() = default;
+
+void ShaderDaemon::start() {
+    throw std::runtime_error("The shaderpipe daemon needs Unix domain sockets.");
+}
+
+void ShaderDaemon::stop() {}
+
+#endif
+
+const fs::path& ShaderDaemon::socket_path() const {
+    return impl->socketPath;
+}
+
+DaemonClient::DaemonClient(fs::path socketPath, const Compiler& fallback)
+    : socketPath(socketPath.empty() ? default_daemon_socket_path() : std::move(socketPath)), fallback(fallback) {}
+
+DaemonClient::~DaemonClient() {
+#ifdef SHADERPIPE_HAS_UNIX_SOCKETS
+    if (fd >= 0)
+        close(fd);
+#endif
+}
+
+bool DaemonClient::connect() {
+    std::lock_guard<std::mutex> lock(mutex);
+#ifdef SHADERPIPE_HAS_UNIX_SOCKETS
+    if (fd < 0)
+        fd = connect_client(socketPath);
+#endif
+    return fd >= 0;
+}
+
+bool DaemonClient::connected() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fd >= 0;
+}
+
+std::optional<CompiledShader> DaemonClient::request(std::vector<uint8_t> payload) {
+#ifdef SHADERPIPE_HAS_UNIX_SOCKETS
+    std::lock_guard<std::mutex> lock(mutex);
+    // Reconnecting is one failed connect() when no daemon is running, cheap enough to try on every request.
+    if (fd < 0)
+        fd = connect_client(socketPath);
+    if (fd < 0)
+        return std::nullopt;
+
+    const uint32_t requestId = nextRequestId++;
+    std::memcpy(payload.data() + 2 * sizeof(uint32_t), &requestId, sizeof(requestId));
+
+    const auto disconnect = [this] {
+        close(fd);
+        fd = -1;
+        return std::nullopt;
+    };
+
+    uint32_t size = 0;
+    if (!send_frame(fd, payload) || !recv_all(fd, &size, sizeof(size)) || size > MaxFrameBytes || size < 2 * sizeof(uint32_t))
+        return disconnect();
+
+    // Word storage keeps the shader binary that follows the two header fields 4 byte aligned.
+    std::vector<uint32_t> words((size + 3) / 4);
+    if (!recv_all(fd, words.data(), size) || words[0] != requestId)
+        return disconnect();
+
+    const auto body = std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(words.data()), size).subspan(2 * sizeof(uint32_t));
+    switch (static_cast<ResponseStatus>(words[1])) {
+    case ResponseStatus::OK:
+        if (auto view = ShaderBinaryView::from_bytes(body))
+            return view->to_compiled_shader();
+        return disconnect();
+    case ResponseStatus::ERROR: {
+        Reader r(body);
+        auto message = r.str();
+        throw std::runtime_error(r.ok ? message : "The shaderpipe daemon reported an error.");
+    }
+    default:
+        return disconnect();
+    }
+#else
+    (void)payload;
+    return std::nullopt;
+#endif
+}
+
+CompiledShader DaemonClient::glsl_to_spirv_with_reflection(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options) {
+    Writer w;
+    w.u32(ProtocolMagic);
+    w.u32(ProtocolVersion);
+    w.u32(0); // request id, filled in once the connection is locked
+    w.u32(static_cast<uint32_t>(RequestKind::COMPILE));
+    w.u32(static_cast<uint32_t>(stage));
+    w.u32(static_cast<uint32_t>(targetVulkanVersion));
+    write_options(w, options);
+    w.str(source);
+
+    if (auto shader = request(std::move(w.bytes)))
+        return std::move(*shader);
+    return fallback.glsl_to_spirv_with_reflection(source, stage, targetVulkanVersion, options);
+}
+
+ShaderReflection DaemonClient::reflect_spirv(std::span<const uint32_t> source) {
+    Writer w;
+    w.u32(ProtocolMagic);
+    w.u32(ProtocolVersion);
+    w.u32(0);
+    w.u32(static_cast<uint32_t>(RequestKind::REFLECT));
+    w.u32(static_cast<uint32_t>(source.size()));
+    w.append(source.data(), source.size_bytes());
+
+    if (auto shader = request(std::move(w.bytes)))
+        return std::move(shader->reflection);
+    return shaderpipe::reflect_spirv(source);
+}
+}
@@ -0,0 +1,175 @@
+/*
+* File: shader_dependency_graph
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_dependency_graph.hpp"
+
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+static constexpr const char* GraphHeader = "shaderpipe-deps 1";
+
+std::string canonical_shader_path(const fs::path& path) {
+    std::error_code ec;
+    auto canonical = fs::weakly_canonical(path, ec);
+    return ec ? path.lexically_normal().string() : canonical.string();
+}
+
+struct DependencyGraph::Impl {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::vector<std::string>> forward;
+    std::unordered_map<std::string, std::unordered_set<std::string>> reverse;
+
+    void unlink(const std::string& shader) {
+        auto it = forward.find(shader);
+        if (it == forward.end())
+            return;
+        for (const auto& dep : it->second) {
+            auto r = reverse.find(dep);
+            if (r == reverse.end())
+                continue;
+            r->second.erase(shader);
+            if (r->second.empty())
+                reverse.erase(r);
+        }
+        forward.erase(it);
+    }
+
+    void link(const std::string& shader, const std::vector<std::string>& includes) {
+        auto& deps = forward[shader];
+        deps = includes;
+        for (const auto& dep : deps)
+            reverse[dep].insert(shader);
+    }
+};
+
+DependencyGraph::DependencyGraph() : impl(std::make_unique<Impl>()) {}
+DependencyGraph::~DependencyGraph() = default;
+
+void DependencyGraph::set_dependencies(const std::string& shader, const std::vector<std::string>& includes) {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->unlink(shader);
+    impl->link(shader, includes);
+}
+
+void DependencyGraph::remove(const std::string& shader) {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->unlink(shader);
+}
+
+void DependencyGraph::clear() {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->forward.clear();
+    impl->reverse.clear();
+}
+
+std::vector<std::string> DependencyGraph::dependencies_of(const std::string& shader) const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    auto it = impl->forward.find(shader);
+    return it == impl->forward.end() ? std::vector<std::string>{} : it->second;
+}
+
+std::vector<std::string> DependencyGraph::affected_shaders(const std::string& file) const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+
+    // The recorded includes are already transitive, so one reverse lookup is enough.
+    std::set<std::string> affected;
+    if (impl->forward.count(file))
+        affected.insert(file);
+    if (auto it = impl->reverse.find(file); it != impl->reverse.end())
+        affected.insert(it->second.begin(), it->second.end());
+
+    return { affected.begin(), affected.end() };
+}
+
+std::vector<std::string> DependencyGraph::shaders() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    std::vector<std::string> out;
+    out.reserve(impl->forward.size());
+    for (const auto& [shader, deps] : impl->forward)
+        out.push_back(shader);
+    return out;
+}
+
+std::vector<std::string> DependencyGraph::files() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    std::vector<std::string> out;
+    out.reserve(impl->forward.size() + impl->reverse.size());
+    for (const auto& [shader, deps] : impl->forward)
+        out.push_back(shader);
+    for (const auto& [header, users] : impl->reverse) {
+        if (!impl->forward.count(header))
+            out.push_back(header);
+    }
+    return out;
+}
+
+// Plain text, one path per line: "S <shader>" followed by its "D <dependency>" lines.
+bool DependencyGraph::save(const fs::path& path) const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+
+    const auto tmp = fs::path(path.string() + ".tmp");
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        if (!out)
+            return false;
+        out << GraphHeader << '\n';
+        for (const auto& [shader, deps] : impl->forward) {
+            out << "S " << shader << '\n';
+            for (const auto& dep : deps)
+                out << "D " << dep << '\n';
+        }
+        if (!out.good())
+            return false;
+    }
+
+    std::error_code ec;
+    fs::rename(tmp, path, ec);
+    return !ec;
+}
+
+bool DependencyGraph::load(const fs::path& path) {
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    std::string line;
+    if (!std::getline(in, line) || line != GraphHeader)
+        return false;
+
+    std::unordered_map<std::string, std::vector<std::string>> forward;
+    std::vector<std::string>* current = nullptr;
+    while (std::getline(in, line)) {
+        if (line.size() < 2 || line[1] != ' ')
+            return false;
+        if (line[0] == 'S')
+            current = &forward[line.substr(2)];
+        else if (line[0] == 'D' && current)
+            current->push_back(line.substr(2));
+        else
+            return false;
+    }
+
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->forward.clear();
+    impl->reverse.clear();
+    for (const auto& [shader, deps] : forward)
+        impl->link(shader, deps);
+    return true;
+}
+}
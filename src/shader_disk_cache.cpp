@@ -0,0 +1,171 @@
+/*
+* File: shader_disk_cache
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_disk_cache.hpp"
+#include "shader_binary.hpp"
+#include "shader_mapped_file.hpp"
+#include "shader_temp_file.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <string>
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+static constexpr const char* EntryExtension = ".spvc";
+
+// Trim down a bit further than the limit so we are not rescanning the directory on every store.
+static constexpr double TrimTarget = 0.9;
+
+// Temp files older than this were left behind by a writer that crashed or got killed, a live store takes moments.
+static constexpr auto StaleTempAge = std::chrono::hours(1);
+
+// "<hash>.spvc.tmp.<token>.<n>", see temp_file_suffix.
+static bool is_temp_file(const fs::path& path) {
+    return path.filename().string().find(std::string(EntryExtension) + ".tmp.") != std::string::npos;
+}
+
+std::string temp_file_suffix() {
+    static const uint64_t processToken = [] {
+        std::random_device rd;
+        return (static_cast<uint64_t>(rd()) << 32) | rd();
+    }();
+    static std::atomic<uint64_t> counter{0};
+
+    return ".tmp." + std::to_string(processToken) + "." + std::to_string(counter.fetch_add(1));
+}
+
+DiskCache::DiskCache(DiskCacheOptions options) : opts(std::move(options)) {
+    std::error_code ec;
+    fs::create_directories(opts.directory, ec);
+
+    uint64_t total = 0;
+    for (auto it = fs::recursive_directory_iterator(opts.directory, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        // Temp files count too, until trim() removes the stale ones they take space like any entry.
+        if (it->is_regular_file(ec) && (it->path().extension() == EntryExtension || is_temp_file(it->path())))
+            total += it->file_size(ec);
+    }
+    approxSize.store(total);
+}
+
+fs::path DiskCache::entry_path(const ShaderHash& key) const {
+    // Fan out over 256 sub directories, huge flat directories get slow on some file systems.
+    const std::string hex = key.to_hex();
+    return opts.directory / hex.substr(0, 2) / (hex + EntryExtension);
+}
+
+std::optional<CompiledShader> DiskCache::load(const ShaderHash& key) const {
+    const auto path = entry_path(key);
+
+    MappedFile file;
+    if (!file.open(path))
+        return std::nullopt;
+
+    const auto view = ShaderBinaryView::from_bytes({ file.data(), file.size() });
+    if (!view)
+        return std::nullopt; // corrupt / old format, the next store overwrites it
+    CompiledShader shader = view->to_compiled_shader();
+
+    // Refresh the entry for LRU eviction. Failing here (e.g. read only cache) is harmless.
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    return shader;
+}
+
+void DiskCache::store(const ShaderHash& key, const CompiledShader& shader) {
+    const std::vector<uint8_t> blob = write_shader_binary(shader);
+
+    const auto path = entry_path(key);
+    const auto tmp = fs::path(path.string() + temp_file_suffix());
+
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+        out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!out.good()) {
+            out.close();
+            fs::remove(tmp, ec);
+            return;
+        }
+    }
+
+    // Readers only ever see a missing file or a complete one.
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return;
+    }
+
+    if (approxSize.fetch_add(blob.size()) + blob.size() > opts.maxSizeBytes)
+        trim();
+}
+
+void DiskCache::trim() {
+    struct Entry {
+        fs::path path;
+        uint64_t size;
+        fs::file_time_type time;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+
+    const auto staleBefore = fs::file_time_type::clock::now() - StaleTempAge;
+
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(opts.directory, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code entryEc;
+        if (!it->is_regular_file(entryEc))
+            continue;
+        const bool temp = is_temp_file(it->path());
+        if (!temp && it->path().extension() != EntryExtension)
+            continue;
+        Entry e{ it->path(), it->file_size(entryEc), it->last_write_time(entryEc) };
+        if (entryEc)
+            continue; // another process removed it meanwhile
+
+        if (temp) {
+            // Fresh ones may still be written to, they only count. Nothing else ever removes abandoned ones.
+            if (e.time < staleBefore && fs::remove(e.path, entryEc))
+                continue;
+            total += e.size;
+            continue;
+        }
+        total += e.size;
+        entries.push_back(std::move(e));
+    }
+
+    const auto target = static_cast<uint64_t>(static_cast<double>(opts.maxSizeBytes) * TrimTarget);
+    if (total > target) {
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+        // Other processes may be trimming at the same time, a failed remove just means someone beat us to it.
+        for (const auto& e : entries) {
+            if (total <= target)
+                break;
+            if (fs::remove(e.path, ec))
+                total -= e.size;
+        }
+    }
+
+    approxSize.store(total);
+}
+}
@@ -0,0 +1,113 @@
+/*
+* File: shader_gl_output
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_gl_output.hpp"
+#include "shader_pipe_internal.hpp"
+#include "shader_trace_internal.hpp"
+
+#include <algorithm>
+
+namespace shaderpipe {
+
+static constexpr size_t SpirvHeaderWords = 5;
+
+static spirv_cross::CompilerGLSL::Options::Precision cross_precision(GlPrecision precision) {
+    switch (precision) {
+    case GlPrecision::LOW:    return spirv_cross::CompilerGLSL::Options::Lowp;
+    case GlPrecision::MEDIUM: return spirv_cross::CompilerGLSL::Options::Mediump;
+    case GlPrecision::HIGH:   return spirv_cross::CompilerGLSL::Options::Highp;
+    }
+    return spirv_cross::CompilerGLSL::Options::Highp;
+}
+
+// The oldest Vulkan environment that accepts the module's SPIR-V version, so validation around the passes
+// does not reject modules made for a newer one.
+static VKVersion vk_version_for_module(std::span<const uint32_t> source) {
+    const uint32_t version = source.size() > 1 ? source[1] : 0;
+    if (version >= 0x00010600) return VKVersion::VK_1_3;
+    if (version >= 0x00010400) return VKVersion::VK_1_2;
+    if (version >= 0x00010100) return VKVersion::VK_1_1;
+    return VKVersion::VK_1_0;
+}
+
+size_t spirv_instruction_count(std::span<const uint32_t> source) {
+    size_t count = 0;
+    for (size_t i = SpirvHeaderWords; i < source.size();) {
+        const uint32_t wordCount = source[i] >> 16;
+        if (wordCount == 0)
+            break; // malformed, do not loop forever
+        ++count;
+        i += wordCount;
+    }
+    return count;
+}
+
+GlOutput spirv_to_gl(std::span<const uint32_t> source, const GlOutputOptions& options) {
+    CompileTrace trace("spirv_to_gl");
+    trace.set_spirv_words(source.size());
+
+    GlOutput out;
+    out.stats.inputWords = source.size();
+    out.stats.inputInstructions = spirv_instruction_count(source);
+
+    OptimizationOptions optimization;
+    if (options.optimize)
+        optimization.level = OptimizationLevel::PERFORMANCE;
+    if (options.relaxPrecision)
+        optimization.customPasses.push_back("--relax-float-ops");
+
+    std::vector<uint32_t> optimized;
+    if (optimization.enabled()) {
+        TraceScope scope(TracePhase::OPTIMIZE);
+        optimized = optimize_spirv(source, vk_version_for_module(source), optimization);
+    } else {
+        optimized.assign(source.begin(), source.end());
+    }
+    out.stats.optimizedWords = optimized.size();
+    out.stats.optimizedInstructions = spirv_instruction_count(optimized);
+
+    {
+        TraceScope scope(TracePhase::CROSS_COMPILE);
+        spirv_cross::CompilerGLSL compiler(optimized.data(), optimized.size());
+
+        auto glslOptions = glsl_options(options.version);
+        glslOptions.fragment.default_float_precision = cross_precision(options.fragmentFloatPrecision);
+        glslOptions.fragment.default_int_precision = cross_precision(options.fragmentIntPrecision);
+        compiler.set_common_options(glslOptions);
+
+        if (options.flattenUniformBuffers) {
+            for (const auto& ubo : compiler.get_shader_resources().uniform_buffers)
+                compiler.flatten_buffer_block(ubo.id);
+        }
+
+        out.glsl = compiler.compile();
+    }
+
+    out.stats.glslBytes = out.glsl.size();
+    out.stats.glslLines = static_cast<size_t>(std::count(out.glsl.begin(), out.glsl.end(), '\n'));
+    trace.succeeded();
+    return out;
+}
+
+GlOutput glsl_to_gl(std::string_view source, ShaderStage stage, const GlOutputOptions& options, const CompileOptions& compileOptions) {
+    CompileTrace trace("glsl_to_gl", compileOptions.sourcePath, stage);
+
+    CompileOptions unoptimized = compileOptions;
+    unoptimized.optimization = {};
+    const auto spirv = default_compiler().glsl_to_spirv(source, stage, VKVersion::VK_1_0, unoptimized);
+
+    auto out = spirv_to_gl(spirv, options);
+    trace.set_spirv_words(out.stats.optimizedWords);
+    trace.succeeded();
+    return out;
+}
+}
@@ -0,0 +1,73 @@
+/*
+* File: shader_includer
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_includer.hpp"
+#include "shader_pipe.hpp"
+
+#include <algorithm>
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+FileIncluder::FileIncluder(const std::vector<fs::path>& searchPaths) : searchPaths(searchPaths) {}
+
+FileIncluder::IncludeResult* FileIncluder::open(const fs::path& path) {
+    // Read, not mapped: headers are edited while we compile, and a mapped file that shrinks raises SIGBUS.
+    // glslang reads the header out of this buffer, it is freed again in releaseInclude.
+    std::string* contents = nullptr;
+    try {
+        contents = new std::string(load_shader_file(path.string()));
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+
+    std::error_code ec;
+    auto canonical = fs::weakly_canonical(path, ec).string();
+    if (ec)
+        canonical = path.string();
+    if (std::find(includedFiles.begin(), includedFiles.end(), canonical) == includedFiles.end())
+        includedFiles.push_back(canonical);
+
+    // The header name handed back becomes the includerName of nested includes, so it has to be the resolved path.
+    return new IncludeResult(canonical, contents->data(), contents->size(), contents);
+}
+
+FileIncluder::IncludeResult* FileIncluder::includeLocal(const char* headerName, const char* includerName, size_t inclusionDepth) {
+    // Relative to the file doing the including first...
+    if (includerName && *includerName) {
+        const auto candidate = fs::path(includerName).parent_path() / headerName;
+        std::error_code ec;
+        if (fs::is_regular_file(candidate, ec))
+            return open(candidate);
+    }
+    // ...then like a <> include.
+    return includeSystem(headerName, includerName, inclusionDepth);
+}
+
+FileIncluder::IncludeResult* FileIncluder::includeSystem(const char* headerName, const char*, size_t) {
+    for (const auto& dir : searchPaths) {
+        const auto candidate = dir / headerName;
+        std::error_code ec;
+        if (fs::is_regular_file(candidate, ec))
+            return open(candidate);
+    }
+    return nullptr;
+}
+
+void FileIncluder::releaseInclude(IncludeResult* result) {
+    if (!result)
+        return;
+    delete static_cast<std::string*>(result->userData);
+    delete result;
+}
+}
@@ -0,0 +1,44 @@
+/*
+* File: shader_includer
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_INCLUDER_HPP
+#define SHADER_PIPE_SHADER_INCLUDER_HPP
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <glslang/Public/ShaderLang.h>
+
+namespace shaderpipe {
+
+// Resolves #include against the including file's directory ("" includes only) and then the search paths.
+// Every header that gets opened is recorded, in canonical form, so callers can build dependency information.
+class FileIncluder : public glslang::TShader::Includer {
+public:
+    explicit FileIncluder(const std::vector<std::filesystem::path>& searchPaths);
+
+    IncludeResult* includeSystem (const char* headerName, const char* includerName, size_t inclusionDepth) override;
+    IncludeResult* includeLocal  (const char* headerName, const char* includerName, size_t inclusionDepth) override;
+    void           releaseInclude(IncludeResult* result) override;
+
+    const std::vector<std::string>& included_files() const { return includedFiles; }
+
+private:
+    IncludeResult* open(const std::filesystem::path& path);
+
+    const std::vector<std::filesystem::path>& searchPaths;
+    std::vector<std::string> includedFiles;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_INCLUDER_HPP
@@ -0,0 +1,187 @@
+/*
+* File: shader_memory_cache
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_memory_cache.hpp"
+#include "shader_compiler.hpp"
+#include "shader_hash.hpp"
+#include "shader_trace_internal.hpp"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace shaderpipe {
+
+// Both result kinds live in the same LRU. The kind is part of the hashed key, so a lookup can never
+// hand back the wrong type.
+enum class EntryKind : uint32_t {
+    COMPILED_SHADER,
+    CROSS_COMPILED_GLSL,
+};
+
+struct ShaderCache::Impl {
+    struct Entry {
+        ShaderHash key;
+        std::shared_ptr<const void> value;
+        uint64_t bytes;
+    };
+
+    uint64_t maxBytes;
+
+    mutable std::mutex mutex;
+    std::list<Entry> lru; // front = most recently used
+    std::unordered_map<ShaderHash, std::list<Entry>::iterator> index;
+    CacheStats counters;
+
+    std::shared_ptr<const void> find(const ShaderHash& key);
+    std::shared_ptr<const void> insert(const ShaderHash& key, std::shared_ptr<const void> value, uint64_t bytes);
+};
+
+std::shared_ptr<const void> ShaderCache::Impl::find(const ShaderHash& key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++counters.misses;
+        return nullptr;
+    }
+    ++counters.hits;
+    lru.splice(lru.begin(), lru, it->second);
+    return it->second->value;
+}
+
+std::shared_ptr<const void> ShaderCache::Impl::insert(const ShaderHash& key, std::shared_ptr<const void> value, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Someone else compiled the same thing while we were busy, keep theirs so everyone shares one object.
+    if (auto it = index.find(key); it != index.end()) {
+        lru.splice(lru.begin(), lru, it->second);
+        return it->second->value;
+    }
+
+    lru.push_front({ key, value, bytes });
+    index.emplace(key, lru.begin());
+    counters.bytes += bytes;
+    ++counters.entries;
+
+    // Never evict the entry we just added, even if it alone is over budget.
+    while (counters.bytes > maxBytes && lru.size() > 1) {
+        auto& victim = lru.back();
+        counters.bytes -= victim.bytes;
+        --counters.entries;
+        ++counters.evictions;
+        index.erase(victim.key);
+        lru.pop_back();
+    }
+
+    return value;
+}
+
+static uint64_t reflection_bytes(const ShaderReflection& r) {
+    uint64_t bytes = sizeof(ShaderReflection);
+    for (const auto& b : r.descriptorBindings)
+        bytes += sizeof(b) + b.name.capacity();
+    bytes += r.pushConstants.size() * sizeof(PushConstantInfo);
+    for (const auto& a : r.inputs)
+        bytes += sizeof(a) + a.name.capacity();
+    for (const auto& a : r.outputs)
+        bytes += sizeof(a) + a.name.capacity();
+    for (const auto& sc : r.specConstants)
+        bytes += sizeof(sc) + sc.name.capacity();
+    for (const auto& b : r.unusedDescriptorBindings)
+        bytes += sizeof(b) + b.name.capacity();
+    return bytes;
+}
+
+ShaderCache::ShaderCache(uint64_t maxBytes) : impl(std::make_unique<Impl>()) {
+    impl->maxBytes = maxBytes;
+}
+
+ShaderCache::~ShaderCache() = default;
+
+std::shared_ptr<const CompiledShader> ShaderCache::glsl_to_spirv_with_reflection(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options) {
+    CompileTrace trace("glsl_to_spirv_with_reflection", options.sourcePath, stage);
+
+    Hasher h;
+    h.update_value(EntryKind::COMPILED_SHADER);
+    h.update_value(stage);
+    h.update_value(targetVulkanVersion);
+    hash_compile_options(h, options);
+    // With includes the raw source says nothing about the headers it pulls in, key on the expanded text instead.
+    if (options.includes_enabled())
+        h.update(compiler.preprocess(source, stage, targetVulkanVersion, options));
+    else
+        h.update(source);
+    const auto key = h.finish();
+
+    std::shared_ptr<const void> hit;
+    {
+        TraceScope scope(TracePhase::CACHE_LOOKUP);
+        hit = impl->find(key);
+    }
+    trace.set_cache(hit ? CacheResult::HIT : CacheResult::MISS);
+    if (hit) {
+        auto shader = std::static_pointer_cast<const CompiledShader>(hit);
+        trace.set_spirv_words(shader->spirv.size());
+        trace.succeeded();
+        return shader;
+    }
+
+    auto shader = std::make_shared<const CompiledShader>(compiler.glsl_to_spirv_with_reflection(source, stage, targetVulkanVersion, options));
+    const uint64_t bytes = sizeof(CompiledShader) + shader->spirv.size() * sizeof(uint32_t) + reflection_bytes(shader->reflection);
+
+    trace.succeeded();
+    return std::static_pointer_cast<const CompiledShader>(impl->insert(key, shader, bytes));
+}
+
+std::shared_ptr<const CompiledShader> ShaderCache::glsl_to_spirv_with_reflection(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion, const CompileOptions& options) {
+    return glsl_to_spirv_with_reflection(default_compiler(), source, stage, targetVulkanVersion, options);
+}
+
+std::shared_ptr<const std::string> ShaderCache::spirv_to_glsl(std::span<const uint32_t> source, GlVersion version) {
+    Hasher h;
+    h.update_value(EntryKind::CROSS_COMPILED_GLSL);
+    h.update_value(version);
+    h.update(source.data(), source.size() * sizeof(uint32_t));
+    const auto key = h.finish();
+
+    CompileTrace trace("spirv_to_glsl");
+    std::shared_ptr<const void> hit;
+    {
+        TraceScope scope(TracePhase::CACHE_LOOKUP);
+        hit = impl->find(key);
+    }
+    trace.set_cache(hit ? CacheResult::HIT : CacheResult::MISS);
+    if (hit) {
+        trace.succeeded();
+        return std::static_pointer_cast<const std::string>(hit);
+    }
+
+    auto glsl = std::make_shared<const std::string>(shaderpipe::spirv_to_glsl(source, version));
+    const uint64_t bytes = sizeof(std::string) + glsl->capacity();
+
+    trace.succeeded();
+    return std::static_pointer_cast<const std::string>(impl->insert(key, glsl, bytes));
+}
+
+CacheStats ShaderCache::stats() const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return impl->counters;
+}
+
+void ShaderCache::clear() {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->lru.clear();
+    impl->index.clear();
+    impl->counters.bytes = 0;
+    impl->counters.entries = 0;
+}
+}
@@ -0,0 +1,88 @@
+/*
+* File: shader_module
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_module.hpp"
+#include "shader_pipe_internal.hpp"
+#include "shader_trace_internal.hpp"
+
+#include <mutex>
+
+#include <spirv_parser.hpp>
+
+namespace shaderpipe {
+
+struct ShaderModule::Impl {
+    std::vector<uint32_t> spirv;
+    spirv_cross::ParsedIR ir;
+
+    mutable std::once_flag reflectionOnce;
+    mutable ShaderReflection reflection;
+};
+
+static spirv_cross::ParsedIR parse_ir(const std::vector<uint32_t>& spirv) {
+    spirv_cross::Parser parser(spirv.data(), spirv.size());
+    parser.parse();
+    return std::move(parser.get_parsed_ir());
+}
+
+ShaderModule::ShaderModule(std::vector<uint32_t> spirv) : impl(std::make_unique<Impl>()) {
+    impl->spirv = std::move(spirv);
+    impl->ir = parse_ir(impl->spirv);
+}
+
+ShaderModule::ShaderModule(CompiledShader shader) : ShaderModule(std::move(shader.spirv)) {
+    impl->reflection = std::move(shader.reflection);
+    std::call_once(impl->reflectionOnce, [] {}); // mark as already reflected
+}
+
+ShaderModule::~ShaderModule() = default;
+ShaderModule::ShaderModule(ShaderModule&&) noexcept = default;
+ShaderModule& ShaderModule::operator=(ShaderModule&&) noexcept = default;
+
+const std::vector<uint32_t>& ShaderModule::spirv() const {
+    return impl->spirv;
+}
+
+const ShaderReflection& ShaderModule::reflection() const {
+    std::call_once(impl->reflectionOnce, [this] {
+        CompileTrace trace("reflect_spirv");
+        TraceScope scope(TracePhase::REFLECT);
+
+        // The compilers take the IR by value, so every caller works on its own copy and the shared IR stays untouched.
+        spirv_cross::Compiler comp(impl->ir);
+        impl->reflection = reflect_compiler(comp);
+        trace.succeeded();
+    });
+    return impl->reflection;
+}
+
+ShaderReflection ShaderModule::reflection(const ReflectionOptions& options) const {
+    CompileTrace trace("reflect_spirv");
+    TraceScope scope(TracePhase::REFLECT);
+
+    spirv_cross::Compiler comp(impl->ir);
+    auto reflection = reflect_compiler(comp, options);
+    trace.succeeded();
+    return reflection;
+}
+
+std::string ShaderModule::to_glsl(GlVersion version) const {
+    CompileTrace trace("spirv_to_glsl");
+    trace.set_spirv_words(impl->spirv.size());
+
+    TraceScope scope(TracePhase::CROSS_COMPILE);
+    spirv_cross::CompilerGLSL compiler(impl->ir);
+    auto glsl = cross_compile_glsl(compiler, version);
+    trace.succeeded();
+    return glsl;
+}
+}
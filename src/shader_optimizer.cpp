@@ -0,0 +1,167 @@
+/*
+* File: shader_optimizer
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_optimizer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <spirv-tools/libspirv.hpp>
+#include <spirv-tools/optimizer.hpp>
+
+namespace shaderpipe {
+
+static spv_target_env vk_version_to_target_env(VKVersion v) {
+    switch (v) {
+    case VKVersion::VK_1_0: return SPV_ENV_VULKAN_1_0;
+    case VKVersion::VK_1_1: return SPV_ENV_VULKAN_1_1;
+    case VKVersion::VK_1_2: return SPV_ENV_VULKAN_1_2;
+    case VKVersion::VK_1_3: return SPV_ENV_VULKAN_1_3;
+    case VKVersion::VK_1_4: return SPV_ENV_VULKAN_1_4;
+    }
+    return SPV_ENV_VULKAN_1_0;
+}
+
+// Collects everything SPIRV-Tools reports so it can be thrown / handed back in one piece.
+static spvtools::MessageConsumer collect_messages(std::string& log) {
+    return [&log](spv_message_level_t, const char*, const spv_position_t& position, const char* message) {
+        log += std::to_string(position.index);
+        log += ": ";
+        log += message;
+        log += '\n';
+    };
+}
+
+bool validate_spirv(std::span<const uint32_t> source, VKVersion targetVulkanVersion, std::string* log) {
+    std::string messages;
+
+    spvtools::SpirvTools tools(vk_version_to_target_env(targetVulkanVersion));
+    tools.SetMessageConsumer(collect_messages(messages));
+
+    const bool valid = tools.Validate(source.data(), source.size());
+    if (log)
+        *log = std::move(messages);
+    return valid;
+}
+
+std::vector<uint32_t> optimize_spirv(std::span<const uint32_t> source, VKVersion targetVulkanVersion, const OptimizationOptions& options) {
+    if (!options.enabled())
+        return { source.begin(), source.end() };
+
+    std::string log;
+    if (options.validateInput && !validate_spirv(source, targetVulkanVersion, &log)) {
+        throw std::runtime_error("SPIR-V failed validation before optimization:\n" + log);
+    }
+
+    spvtools::Optimizer optimizer(vk_version_to_target_env(targetVulkanVersion));
+    optimizer.SetMessageConsumer(collect_messages(log));
+
+    switch (options.level) {
+    case OptimizationLevel::PERFORMANCE: optimizer.RegisterPerformancePasses(); break;
+    case OptimizationLevel::SIZE: optimizer.RegisterSizePasses(); break;
+    default: break;
+    }
+
+    if (!options.customPasses.empty() && !optimizer.RegisterPassesFromFlags(options.customPasses)) {
+        throw std::runtime_error("Invalid optimizer pass list:\n" + log);
+    }
+
+    // Validation is done explicitly around the run so it can be toggled independently for input and output.
+    std::vector<uint32_t> optimized;
+    if (!optimizer.Run(source.data(), source.size(), &optimized, spvtools::ValidatorOptions(), true)) {
+        throw std::runtime_error("SPIR-V optimization failed:\n" + log);
+    }
+
+    if (options.validateOutput && !validate_spirv(optimized, targetVulkanVersion, &log)) {
+        throw std::runtime_error("SPIR-V failed validation after optimization:\n" + log);
+    }
+
+    return optimized;
+}
+
+// SPIR-V literals narrower than a word are sign extended for signed integers and zero extended for everything else.
+static uint64_t literal_bits(const SpecConstantInfo& constant, uint64_t bits) {
+    if (constant.bitWidth >= 64)
+        return bits;
+    const uint32_t shift = 64 - constant.bitWidth;
+    if (constant.type == ScalarType::INT)
+        return static_cast<uint64_t>(static_cast<int64_t>(bits << shift) >> shift);
+    return (bits << shift) >> shift;
+}
+
+CompiledShader specialize_spirv(std::span<const uint32_t> source, std::span<const SpecConstantValue> values, VKVersion targetVulkanVersion) {
+    const auto before = reflect_spirv(source);
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> bitPatterns;
+    for (const auto& value : values) {
+        auto it = std::find_if(before.specConstants.begin(), before.specConstants.end(),
+                               [&](const SpecConstantInfo& sc) { return sc.constantId == value.constantId; });
+        if (it == before.specConstants.end())
+            throw std::runtime_error("Module has no specialization constant with constant_id " + std::to_string(value.constantId) + ".");
+
+        // The pass wants the value as words of the constant's own width, so from_uint(-1) on a 16 bit constant or
+        // from_int(-1) on a 32 bit one are cut down to that width first.
+        const uint64_t bits = literal_bits(*it, value.bits);
+        auto& words = bitPatterns[value.constantId];
+        words = { static_cast<uint32_t>(bits) };
+        if (it->bitWidth > 32)
+            words.push_back(static_cast<uint32_t>(bits >> 32));
+    }
+
+    std::string log;
+    spvtools::Optimizer optimizer(vk_version_to_target_env(targetVulkanVersion));
+    optimizer.SetMessageConsumer(collect_messages(log));
+    optimizer.RegisterPass(spvtools::CreateSetSpecConstantDefaultValuePass(bitPatterns))
+             .RegisterPass(spvtools::CreateFreezeSpecConstantValuePass())
+             .RegisterPass(spvtools::CreateFoldSpecConstantOpAndCompositePass())
+             .RegisterPass(spvtools::CreateUnifyConstantPass())
+             .RegisterPass(spvtools::CreateDeadBranchElimPass())
+             .RegisterPass(spvtools::CreateAggressiveDCEPass())
+             .RegisterPass(spvtools::CreateCFGCleanupPass())
+             .RegisterPass(spvtools::CreateEliminateDeadConstantPass());
+
+    std::vector<uint32_t> specialized;
+    if (!optimizer.Run(source.data(), source.size(), &specialized, spvtools::ValidatorOptions(), true)) {
+        throw std::runtime_error("SPIR-V specialization failed:\n" + log);
+    }
+
+    if (!validate_spirv(specialized, targetVulkanVersion, &log)) {
+        throw std::runtime_error("SPIR-V failed validation after specialization:\n" + log);
+    }
+
+    auto reflection = reflect_spirv(specialized);
+    return { std::move(specialized), std::move(reflection) };
+}
+
+std::vector<uint32_t> compact_spirv(std::span<const uint32_t> source, bool stripDebugInfo, bool compactIds) {
+    if (!stripDebugInfo && !compactIds)
+        return { source.begin(), source.end() };
+
+    std::string log;
+    // Universal environment, the module may target any Vulkan version.
+    spvtools::Optimizer optimizer(SPV_ENV_UNIVERSAL_1_6);
+    optimizer.SetMessageConsumer(collect_messages(log));
+    if (stripDebugInfo) {
+        optimizer.RegisterPass(spvtools::CreateStripDebugInfoPass())
+                 .RegisterPass(spvtools::CreateStripNonSemanticInfoPass());
+    }
+    if (compactIds)
+        optimizer.RegisterPass(spvtools::CreateCompactIdsPass());
+
+    std::vector<uint32_t> compacted;
+    if (!optimizer.Run(source.data(), source.size(), &compacted, spvtools::ValidatorOptions(), true)) {
+        throw std::runtime_error("SPIR-V compaction failed:\n" + log);
+    }
+    return compacted;
+}
+}
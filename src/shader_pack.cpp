@@ -0,0 +1,287 @@
+/*
+* File: shader_pack
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_pack.hpp"
+#include "shader_optimizer.hpp"
+#include "shader_temp_file.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+// Layout: PackHeader | IndexEntry[entryCount] sorted by key | blobs.
+// Reflection blobs are 4 byte aligned so ShaderBinaryView can read them in place.
+static constexpr uint32_t PackMagic = 0x4B505053; // "SPPK"
+static constexpr uint32_t PackVersion = 4;        // bump whenever the layout or the SPIR-V encoding changes
+
+struct ShaderPack::IndexEntry {
+    ShaderHash key;
+    uint32_t reflectionOffset;
+    uint32_t reflectionSize;
+    uint32_t spirvOffset;
+    uint32_t spirvSize;  // encoded bytes
+    uint32_t spirvWords; // decoded
+    uint32_t reserved;
+};
+static_assert(sizeof(ShaderPack::IndexEntry) == 56, "Pack records are read straight from the file.");
+
+namespace {
+using IndexEntry = ShaderPack::IndexEntry;
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(PackHeader) == 16, "Pack records are read straight from the file.");
+
+// LEB128. After id compaction almost every operand fits into one or two bytes instead of four.
+void put_varint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+bool get_varint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+    v = 0;
+    for (uint32_t shift = 0; shift < 35; shift += 7) {
+        if (p == end)
+            return false;
+        const uint8_t byte = *p++;
+        v |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// The 5 word header, then per instruction: opcode, word count, operands. Splitting the first instruction word keeps
+// it at two bytes instead of the three a varint of (count << 16 | opcode) would take.
+std::vector<uint8_t> encode_spirv(std::span<const uint32_t> words) {
+    if (words.size() < 5)
+        throw std::runtime_error("Not a SPIR-V module.");
+
+    std::vector<uint8_t> out;
+    out.reserve(words.size() * 2);
+    for (size_t i = 0; i < 5; ++i)
+        put_varint(out, words[i]);
+
+    for (size_t i = 5; i < words.size();) {
+        const uint32_t count = words[i] >> 16;
+        if (count == 0 || i + count > words.size())
+            throw std::runtime_error("Malformed SPIR-V instruction at word " + std::to_string(i) + ".");
+        put_varint(out, words[i] & 0xffff);
+        put_varint(out, count);
+        for (size_t w = 1; w < count; ++w)
+            put_varint(out, words[i + w]);
+        i += count;
+    }
+    return out;
+}
+
+std::optional<std::vector<uint32_t>> decode_spirv(const uint8_t* p, size_t size, uint32_t wordCount) {
+    // Every word takes at least one byte, so a larger count comes from a damaged index. Checked before reserving,
+    // a hostile count would otherwise ask for up to 16 GiB.
+    if (wordCount > size)
+        return std::nullopt;
+
+    const uint8_t* end = p + size;
+    std::vector<uint32_t> words;
+    words.reserve(wordCount);
+
+    uint32_t v;
+    for (int i = 0; i < 5; ++i) {
+        if (!get_varint(p, end, v))
+            return std::nullopt;
+        words.push_back(v);
+    }
+
+    while (words.size() < wordCount) {
+        uint32_t opcode, count;
+        if (!get_varint(p, end, opcode) || !get_varint(p, end, count) || count == 0 || opcode > 0xffff ||
+            count > 0xffff || words.size() + count > wordCount)
+            return std::nullopt;
+        words.push_back((count << 16) | opcode);
+        for (uint32_t w = 1; w < count; ++w) {
+            if (!get_varint(p, end, v))
+                return std::nullopt;
+            words.push_back(v);
+        }
+    }
+
+    if (p != end)
+        return std::nullopt;
+    return words;
+}
+
+uint32_t align4(size_t v) {
+    return static_cast<uint32_t>((v + 3) & ~size_t(3));
+}
+}
+
+ShaderPackWriter::ShaderPackWriter(ShaderPackOptions options) : options(options) {}
+
+void ShaderPackWriter::add(const ShaderHash& key, const CompiledShader& shader) {
+    Entry entry;
+    const auto spirv = compact_spirv(shader.spirv, options.stripDebugInfo, options.compactIds);
+    entry.spirv = encode_spirv(spirv);
+    entry.spirvWords = static_cast<uint32_t>(spirv.size());
+    entry.reflection = write_shader_binary(CompiledShader{ {}, shader.reflection });
+    entries[key] = std::move(entry);
+}
+
+std::vector<uint8_t> ShaderPackWriter::serialize() const {
+    PackHeader header{ PackMagic, PackVersion, static_cast<uint32_t>(entries.size()), 0 };
+
+    std::vector<IndexEntry> index;
+    index.reserve(entries.size());
+    size_t offset = sizeof(PackHeader) + entries.size() * sizeof(IndexEntry);
+    for (const auto& [key, entry] : entries) {
+        IndexEntry e{};
+        e.key = key;
+        e.reflectionOffset = static_cast<uint32_t>(offset);
+        e.reflectionSize = static_cast<uint32_t>(entry.reflection.size());
+        offset = align4(offset + entry.reflection.size());
+        e.spirvOffset = static_cast<uint32_t>(offset);
+        e.spirvSize = static_cast<uint32_t>(entry.spirv.size());
+        e.spirvWords = entry.spirvWords;
+        offset = align4(offset + entry.spirv.size());
+        index.push_back(e);
+    }
+    if (offset > UINT32_MAX)
+        throw std::runtime_error("Shader pack would exceed 4 GiB.");
+
+    std::vector<uint8_t> out(offset, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!index.empty())
+        std::memcpy(out.data() + sizeof(header), index.data(), index.size() * sizeof(IndexEntry));
+
+    size_t i = 0;
+    for (const auto& [key, entry] : entries) {
+        std::memcpy(out.data() + index[i].reflectionOffset, entry.reflection.data(), entry.reflection.size());
+        std::memcpy(out.data() + index[i].spirvOffset, entry.spirv.data(), entry.spirv.size());
+        ++i;
+    }
+    return out;
+}
+
+bool ShaderPackWriter::write(const fs::path& path) const {
+    const auto blob = serialize();
+    // Unique so two processes writing the same pack never interleave, the last rename wins with a complete file.
+    const auto tmp = fs::path(path.string() + temp_file_suffix());
+
+    std::error_code ec;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return false;
+        out.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        if (!out.good()) {
+            out.close();
+            fs::remove(tmp, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+bool ShaderPack::open(const fs::path& path) {
+    close();
+    if (!file.open(path))
+        return false;
+
+    PackHeader header;
+    if (file.size() < sizeof(header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    // Only the header and the index are checked here, entries are checked when they are looked up.
+    if (header.magic != PackMagic || header.version != PackVersion ||
+        sizeof(PackHeader) + static_cast<uint64_t>(header.entryCount) * sizeof(IndexEntry) > file.size()) {
+        close();
+        return false;
+    }
+
+    index = file.data() + sizeof(PackHeader);
+    entryCount = header.entryCount;
+    return true;
+}
+
+void ShaderPack::close() {
+    file.close();
+    index = nullptr;
+    entryCount = 0;
+}
+
+const ShaderPack::IndexEntry* ShaderPack::find(const ShaderHash& key) const {
+    const auto* begin = reinterpret_cast<const IndexEntry*>(index);
+    const auto* end = begin + entryCount;
+    const auto* it = std::lower_bound(begin, end, key, [](const IndexEntry& e, const ShaderHash& k) { return e.key < k; });
+    if (it == end || it->key != key)
+        return nullptr;
+
+    // A damaged entry reads as missing rather than running off the end of the mapping.
+    const uint64_t size = file.size();
+    if (static_cast<uint64_t>(it->reflectionOffset) + it->reflectionSize > size ||
+        static_cast<uint64_t>(it->spirvOffset) + it->spirvSize > size)
+        return nullptr;
+    return it;
+}
+
+bool ShaderPack::contains(const ShaderHash& key) const {
+    return find(key) != nullptr;
+}
+
+std::optional<ShaderBinaryView> ShaderPack::reflection(const ShaderHash& key) const {
+    const auto* e = find(key);
+    if (!e)
+        return std::nullopt;
+    return ShaderBinaryView::from_bytes({ file.data() + e->reflectionOffset, e->reflectionSize });
+}
+
+std::optional<std::vector<uint32_t>> ShaderPack::load_spirv(const ShaderHash& key) const {
+    const auto* e = find(key);
+    if (!e)
+        return std::nullopt;
+    return decode_spirv(file.data() + e->spirvOffset, e->spirvSize, e->spirvWords);
+}
+
+std::optional<CompiledShader> ShaderPack::load(const ShaderHash& key) const {
+    auto view = reflection(key);
+    if (!view)
+        return std::nullopt;
+    auto spirv = load_spirv(key);
+    if (!spirv)
+        return std::nullopt;
+
+    CompiledShader shader = view->to_compiled_shader();
+    shader.spirv = std::move(*spirv);
+    return shader;
+}
+}
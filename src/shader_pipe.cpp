@@ -1,449 +1,522 @@
-/*
-* File: shader_pipe
-* Project: shader-pipe
-* Author: Collin Longoria
-* Created on: 10/2/2025
-*
-* Copyright (c) 2025 Collin Longoria
-*
-* This software is released under the MIT License.
-* https://opensource.org/licenses/MIT
-*/
-
-#include "shader_pipe.hpp"
-
-#include <fstream>
-#include <string>
-#include <sstream>
-
-#include <vulkan/vulkan.h>
-#include <glslang/Public/ShaderLang.h>
-#include <SPIRV/GlslangToSpv.h>
-#include <glslang/Include/ResourceLimits.h>
-#include <spirv_cross.hpp>
-#include <spirv_glsl.hpp>
-
-static const TBuiltInResource DefaultTBuiltInResource = {
-    /* .MaxLights = */ 32,
-    /* .MaxClipPlanes = */ 6,
-    /* .MaxTextureUnits = */ 32,
-    /* .MaxTextureCoords = */ 32,
-    /* .MaxVertexAttribs = */ 64,
-    /* .MaxVertexUniformComponents = */ 4096,
-    /* .MaxVaryingFloats = */ 64,
-    /* .MaxVertexTextureImageUnits = */ 32,
-    /* .MaxCombinedTextureImageUnits = */ 80,
-    /* .MaxTextureImageUnits = */ 32,
-    /* .MaxFragmentUniformComponents = */ 4096,
-    /* .MaxDrawBuffers = */ 32,
-    /* .MaxVertexUniformVectors = */ 128,
-    /* .MaxVaryingVectors = */ 8,
-    /* .MaxFragmentUniformVectors = */ 16,
-    /* .MaxVertexOutputVectors = */ 16,
-    /* .MaxFragmentInputVectors = */ 15,
-    /* .MinProgramTexelOffset = */ -8,
-    /* .MaxProgramTexelOffset = */ 7,
-    /* .MaxClipDistances = */ 8,
-    /* .MaxComputeWorkGroupCountX = */ 65535,
-    /* .MaxComputeWorkGroupCountY = */ 65535,
-    /* .MaxComputeWorkGroupCountZ = */ 65535,
-    /* .MaxComputeWorkGroupSizeX = */ 1024,
-    /* .MaxComputeWorkGroupSizeY = */ 1024,
-    /* .MaxComputeWorkGroupSizeZ = */ 64,
-    /* .MaxComputeUniformComponents = */ 1024,
-    /* .MaxComputeTextureImageUnits = */ 16,
-    /* .MaxComputeImageUniforms = */ 8,
-    /* .MaxComputeAtomicCounters = */ 8,
-    /* .MaxComputeAtomicCounterBuffers = */ 1,
-    /* .MaxVaryingComponents = */ 60,
-    /* .MaxVertexOutputComponents = */ 64,
-    /* .MaxGeometryInputComponents = */ 64,
-    /* .MaxGeometryOutputComponents = */ 128,
-    /* .MaxFragmentInputComponents = */ 128,
-    /* .MaxImageUnits = */ 8,
-    /* .MaxCombinedImageUnitsAndFragmentOutputs = */ 8,
-    /* .MaxCombinedShaderOutputResources = */ 8,
-    /* .MaxImageSamples = */ 0,
-    /* .MaxVertexImageUniforms = */ 0,
-    /* .MaxTessControlImageUniforms = */ 0,
-    /* .MaxTessEvaluationImageUniforms = */ 0,
-    /* .MaxGeometryImageUniforms = */ 0,
-    /* .MaxFragmentImageUniforms = */ 8,
-    /* .MaxCombinedImageUniforms = */ 8,
-    /* .MaxGeometryTextureImageUnits = */ 16,
-    /* .MaxGeometryOutputVertices = */ 256,
-    /* .MaxGeometryTotalOutputComponents = */ 1024,
-    /* .MaxGeometryUniformComponents = */ 1024,
-    /* .MaxGeometryVaryingComponents = */ 64,
-    /* .MaxTessControlInputComponents = */ 128,
-    /* .MaxTessControlOutputComponents = */ 128,
-    /* .MaxTessControlTextureImageUnits = */ 16,
-    /* .MaxTessControlUniformComponents = */ 1024,
-    /* .MaxTessControlTotalOutputComponents = */ 4096,
-    /* .MaxTessEvaluationInputComponents = */ 128,
-    /* .MaxTessEvaluationOutputComponents = */ 128,
-    /* .MaxTessEvaluationTextureImageUnits = */ 16,
-    /* .MaxTessEvaluationUniformComponents = */ 1024,
-    /* .MaxTessPatchComponents = */ 120,
-    /* .MaxPatchVertices = */ 32,
-    /* .MaxTessGenLevel = */ 64,
-    /* .MaxViewports = */ 16,
-    /* .MaxVertexAtomicCounters = */ 0,
-    /* .MaxTessControlAtomicCounters = */ 0,
-    /* .MaxTessEvaluationAtomicCounters = */ 0,
-    /* .MaxGeometryAtomicCounters = */ 0,
-    /* .MaxFragmentAtomicCounters = */ 8,
-    /* .MaxCombinedAtomicCounters = */ 8,
-    /* .MaxAtomicCounterBindings = */ 1,
-    /* .MaxVertexAtomicCounterBuffers = */ 0,
-    /* .MaxTessControlAtomicCounterBuffers = */ 0,
-    /* .MaxTessEvaluationAtomicCounterBuffers = */ 0,
-    /* .MaxGeometryAtomicCounterBuffers = */ 0,
-    /* .MaxFragmentAtomicCounterBuffers = */ 1,
-    /* .MaxCombinedAtomicCounterBuffers = */ 1,
-    /* .MaxAtomicCounterBufferSize = */ 16384,
-    /* .MaxTransformFeedbackBuffers = */ 4,
-    /* .MaxTransformFeedbackInterleavedComponents = */ 64,
-    /* .MaxCullDistances = */ 8,
-    /* .MaxCombinedClipAndCullDistances = */ 8,
-    /* .MaxSamples = */ 4,
-    /* .maxMeshOutputVerticesNV = */ 256,
-    /* .maxMeshOutputPrimitivesNV = */ 512,
-    /* .maxMeshWorkGroupSizeX_NV = */ 32,
-    /* .maxMeshWorkGroupSizeY_NV = */ 1,
-    /* .maxMeshWorkGroupSizeZ_NV = */ 1,
-    /* .maxTaskWorkGroupSizeX_NV = */ 32,
-    /* .maxTaskWorkGroupSizeY_NV = */ 1,
-    /* .maxTaskWorkGroupSizeZ_NV = */ 1,
-    /* .maxMeshViewCountNV = */ 4,
-    /* .maxMeshOutputVerticesEXT = */ 256,
-    /* .maxMeshOutputPrimitivesEXT = */ 256,
-    /* .maxMeshWorkGroupSizeX_EXT = */ 128,
-    /* .maxMeshWorkGroupSizeY_EXT = */ 128,
-    /* .maxMeshWorkGroupSizeZ_EXT = */ 128,
-    /* .maxTaskWorkGroupSizeX_EXT = */ 128,
-    /* .maxTaskWorkGroupSizeY_EXT = */ 128,
-    /* .maxTaskWorkGroupSizeZ_EXT = */ 128,
-    /* .maxMeshViewCountEXT = */ 4,
-    /* .maxDualSourceDrawBuffersEXT = */ 1,
-
-    /* .limits = */ {
-        /* .nonInductiveForLoops = */ 1,
-        /* .whileLoops = */ 1,
-        /* .doWhileLoops = */ 1,
-        /* .generalUniformIndexing = */ 1,
-        /* .generalAttributeMatrixVectorIndexing = */ 1,
-        /* .generalVaryingIndexing = */ 1,
-        /* .generalSamplerIndexing = */ 1,
-        /* .generalVariableIndexing = */ 1,
-        /* .generalConstantMatrixVectorIndexing = */ 1,
-    }};
-
-namespace shaderpipe {
-
-static VkShaderStageFlagBits exec_model_to_stage(spirv_cross::ExecutionModel m) {
-    switch (m) {
-    case spv::ExecutionModelVertex: return VK_SHADER_STAGE_VERTEX_BIT;
-    case spv::ExecutionModelTessellationControl: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
-    case spv::ExecutionModelTessellationEvaluation: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
-    case spv::ExecutionModelGeometry: return VK_SHADER_STAGE_GEOMETRY_BIT;
-    case spv::ExecutionModelFragment: return VK_SHADER_STAGE_FRAGMENT_BIT;
-    case spv::ExecutionModelGLCompute: return VK_SHADER_STAGE_COMPUTE_BIT;
-    case spv::ExecutionModelRayGenerationKHR: return VK_SHADER_STAGE_RAYGEN_BIT_KHR;
-    case spv::ExecutionModelIntersectionKHR: return VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
-    case spv::ExecutionModelAnyHitKHR: return VK_SHADER_STAGE_ANY_HIT_BIT_KHR;
-    case spv::ExecutionModelClosestHitKHR: return VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
-    case spv::ExecutionModelMissKHR: return VK_SHADER_STAGE_MISS_BIT_KHR;
-    case spv::ExecutionModelCallableKHR: return VK_SHADER_STAGE_CALLABLE_BIT_KHR;
-    case spv::ExecutionModelTaskEXT: return VK_SHADER_STAGE_TASK_BIT_EXT;
-    case spv::ExecutionModelMeshEXT: return VK_SHADER_STAGE_MESH_BIT_EXT;
-    default: return static_cast<VkShaderStageFlagBits>(0);
-    }
-}
-
-static EShLanguage shader_stage_to_glslang (ShaderStage s) {
-    switch (s) {
-    default: case ShaderStage::VERTEX: return EShLangVertex;
-    case ShaderStage::TESS_CONTROL: return EShLangTessControl;
-    case ShaderStage::TESS_EVAL: return EShLangTessEvaluation;
-    case ShaderStage::GEOMETRY: return EShLangGeometry;
-    case ShaderStage::FRAGMENT: return EShLangFragment;
-    case ShaderStage::COMPUTE: return EShLangCompute;
-    case ShaderStage::RAYGEN: return EShLangRayGen;
-    case ShaderStage::INTERSECT: return EShLangIntersect;
-    case ShaderStage::ANY_HIT: return EShLangAnyHit;
-    case ShaderStage::CLOSEST_HIT: return EShLangClosestHit;
-    case ShaderStage::MISS: return EShLangMiss;
-    case ShaderStage::CALLABLE: return EShLangCallable;
-    case ShaderStage::TASK: return EShLangTask;
-    case ShaderStage::MESH: return EShLangMesh;
-    }  // not sure what else to default to
-};
-
-static uint32_t gl_version_enum_to_int (GlVersion v) {
-    switch (v) {
-    case GlVersion::GL_310: return 310;
-    case GlVersion::GL_330: return 330;
-    default: case GlVersion::GL_450: return 450;
-        // Maybe default should be 310
-    }
-};
-
-static glslang::EShTargetClientVersion vk_version_to_glslang(VKVersion v) {
-    switch (v) {
-    case VKVersion::VK_1_0: return glslang::EShTargetVulkan_1_0;
-    case VKVersion::VK_1_1: return glslang::EShTargetVulkan_1_1;
-    case VKVersion::VK_1_2: return glslang::EShTargetVulkan_1_2;
-    case VKVersion::VK_1_3: return glslang::EShTargetVulkan_1_3;
-    case VKVersion::VK_1_4: return glslang::EShTargetVulkan_1_4;
-    }
-    return glslang::EShTargetVulkan_1_0;
-}
-
-static glslang::EShTargetLanguageVersion vk_version_to_spirv_version(VKVersion v) {
-    switch (v) {
-    case VKVersion::VK_1_0: return glslang::EShTargetSpv_1_0;
-    case VKVersion::VK_1_1: return glslang::EShTargetSpv_1_3;
-    case VKVersion::VK_1_2: return glslang::EShTargetSpv_1_5;
-    case VKVersion::VK_1_3:
-    case VKVersion::VK_1_4:
-        return glslang::EShTargetSpv_1_6; // TODO: may need to handle compatability for spv 1.5
-    }
-    return glslang::EShTargetSpv_1_0;
-}
-
-static uint32_t descriptor_count_from_type(const spirv_cross::Compiler& comp, const spirv_cross::SPIRType& type) {
-    // No array => single descriptor
-    if (type.array.empty())
-        return 1;
-
-    uint32_t total = 1;
-
-    // Each dimension can be:
-    //  - a literal (array_size_literal[i] == true)  => use that value
-    //  - a specialization / non-literal             => conservatively use 1
-    //  - a runtime array (size 0)                   => treat as 1 for descriptor count
-    for (size_t i = 0; i < type.array.size(); ++i)
-    {
-        uint32_t dim = 1;
-
-        if (type.array_size_literal.size() > i && type.array_size_literal[i])
-        {
-            // Literal size directly in the SPIR-V
-            dim = type.array[i];
-        }
-        else
-        {
-            // Non-literal (specialization constant) or missing literal flag:
-            // We cannot legally evaluate it here (no public API for that),
-            // so use 1 to keep descriptor count valid.
-            dim = 1;
-        }
-
-        // Runtime arrays sometimes come through as 0. Clamp to 1 for descriptor count.
-        if (dim == 0)
-            dim = 1;
-
-        total *= dim;
-    }
-
-    return total == 0 ? 1u : total;
-}
-
-static void add_descriptor_from_resource(ShaderReflection& out,
-                                         const spirv_cross::Compiler& comp,
-                                         const spirv_cross::Resource& res,
-                                         VkDescriptorType dtype,
-                                         VkShaderStageFlags stageFlags)
-{
-    const auto& type = comp.get_type(res.type_id);
-    DescriptorBindingInfo info{};
-    info.set    = comp.get_decoration(res.id, spv::DecorationDescriptorSet);
-    info.binding= comp.get_decoration(res.id, spv::DecorationBinding);
-    info.name   = comp.get_name(res.id);
-    if (info.name.empty())
-        info.name = comp.get_fallback_name(res.id);
-    info.type   = dtype;
-    info.count  = descriptor_count_from_type(comp, type);
-    info.stageFlags = stageFlags;
-    out.descriptorBindings.push_back(std::move(info));
-}
-
-uint32_t get_glsl_version(const std::string& source) {
-    static std::string substr = "#version";
-
-    std::size_t pos = source.find(substr);
-    if (pos != std::string::npos) {
-        std::size_t end = source.find('\n', pos);
-        std::string line = source.substr(pos, end - pos);
-
-        std::istringstream iss(line);
-        std::string directive, versionStr, profile;
-        iss >> directive >> versionStr >> profile; // profile can be safely ignored for now.
-
-        if (directive == "#version") {
-            int version = std::stoi(versionStr);
-            return version;
-        }
-    }
-    return 0;
-}
-
-std::string load_shader_file(const std::string& filename) {
-    std::ifstream file(filename);
-
-    if (!file.is_open()) {
-        throw std::runtime_error("Shader file could not be opened.");
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-
-    file.close();
-
-    return buffer.str();
-}
-
-std::vector<uint32_t> glsl_to_spirv(const std::string &source, ShaderStage stage, VKVersion targetVulkanVersion) {
-    const char* glslSource = source.c_str();
-
-    glslang::InitializeProcess();
-
-    auto sStage = shader_stage_to_glslang(stage);
-    glslang::TShader shader(sStage);
-    shader.setStrings(&glslSource, 1);
-
-    uint32_t glslVersion = get_glsl_version(source);
-    const auto vulkanVersion = vk_version_to_glslang(targetVulkanVersion);
-    const auto spvVersion = vk_version_to_spirv_version(targetVulkanVersion);
-
-    shader.setEnvInput(glslang::EShSourceGlsl, sStage, glslang::EShClientVulkan, static_cast<int>(glslVersion));
-    shader.setEnvClient(glslang::EShClientVulkan, vulkanVersion);
-    shader.setEnvTarget(glslang::EShTargetSpv, spvVersion);
-
-    if (!shader.parse(&DefaultTBuiltInResource, 450, false, EShMsgDefault)) {
-        throw std::runtime_error(shader.getInfoLog());
-    }
-
-    glslang::TProgram program;
-    program.addShader(&shader);
-
-    if (!program.link(EShMsgDefault)) {
-        throw std::runtime_error(program.getInfoLog());
-    }
-
-    std::vector<uint32_t> spirv;
-    glslang::GlslangToSpv(*program.getIntermediate(sStage), spirv);
-
-    glslang::FinalizeProcess();
-
-    return spirv;
-}
-
-CompiledShader glsl_to_spirv_with_reflection(const std::string &source, ShaderStage stage, VKVersion targetVulkanVersion) noexcept {
-    auto spirv = glsl_to_spirv(source, stage, targetVulkanVersion);
-    auto refl = reflect_spirv(spirv);
-    return { std::move(spirv), std::move(refl) };
-}
-
-std::string spirv_to_glsl (const std::vector<uint32_t>& source, GlVersion version) {
-    spirv_cross::CompilerGLSL compiler(source);
-
-    // Options for GLSL output
-    spirv_cross::CompilerGLSL::Options options;
-    options.version = gl_version_enum_to_int(version);
-    options.es = false;
-    options.vulkan_semantics = false;
-    options.separate_shader_objects = false;
-    options.enable_420pack_extension = (version != GlVersion::GL_450); // TODO: If GL versions are extended, this line will need to be altered to properly handle more than one version that doesn't need the extension.
-
-    compiler.set_common_options(options);
-
-    return compiler.compile();
-}
-
-SHADERPIPE_API ShaderReflection reflect_spirv (const std::vector<uint32_t>& source) {
-  ShaderReflection reflection{};
-
-    spirv_cross::Compiler comp(source);
-
-    // Determine stage flags from execution model.
-    auto stageBit = exec_model_to_stage(comp.get_execution_model());
-    VkShaderStageFlags stageFlags = stageBit ? (VkShaderStageFlags)stageBit : 0;
-
-    // Query all resources.
-    spirv_cross::ShaderResources res = comp.get_shader_resources();
-
-    // Descriptors
-    for (auto& ubo : res.uniform_buffers) {
-        add_descriptor_from_resource(reflection, comp, ubo, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, stageFlags);
-    }
-    for (auto& ssbo : res.storage_buffers) {
-        add_descriptor_from_resource(reflection, comp, ssbo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stageFlags);
-    }
-    for (auto& img : res.sampled_images) {
-        // Combined image-sampler
-        add_descriptor_from_resource(reflection, comp, img, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, stageFlags);
-    }
-    for (auto& img : res.separate_images) {
-        add_descriptor_from_resource(reflection, comp, img, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, stageFlags);
-    }
-    for (auto& smp : res.separate_samplers) {
-        add_descriptor_from_resource(reflection, comp, smp, VK_DESCRIPTOR_TYPE_SAMPLER, stageFlags);
-    }
-    for (auto& img : res.storage_images) {
-        add_descriptor_from_resource(reflection, comp, img, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, stageFlags);
-    }
-    for (auto& inAtt : res.subpass_inputs) {
-        add_descriptor_from_resource(reflection, comp, inAtt, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, stageFlags);
-    }
-#ifdef VK_KHR_acceleration_structure
-    for (auto& as : res.acceleration_structures) {
-        add_descriptor_from_resource(reflection, comp, as, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR, stageFlags);
-    }
-#endif
-
-    // Push Constants
-    for (auto& pcb : res.push_constant_buffers) {
-        // The push constant buffer is a single struct; get its declared size.
-        const auto& type = comp.get_type(pcb.base_type_id);
-        uint32_t size = static_cast<uint32_t>(comp.get_declared_struct_size(type));
-
-        // Compute minimal/active ranges if you want finer granularity:
-        // auto ranges = comp.get_active_buffer_ranges(pcb.id); (optional)
-        PushConstantInfo pci{};
-        pci.offset = 0;
-        pci.size   = size;
-        pci.stageFlags = stageFlags;
-        reflection.pushConstants.push_back(pci);
-    }
-
-    // Stage Inputs
-    for (auto& in : res.stage_inputs) {
-        const auto& t = comp.get_type(in.type_id);
-        InputAttributeInfo ai{};
-        ai.location = comp.get_decoration(in.id, spv::DecorationLocation);
-        ai.name     = comp.get_name(in.id);
-        if (ai.name.empty())
-            ai.name = comp.get_fallback_name(in.id);
-        ai.vecSize  = t.vecsize;
-        ai.bitWidth = t.width;
-        reflection.inputs.push_back(std::move(ai));
-    }
-
-    // Stage Outputs
-    for (auto& outRes : res.stage_outputs) {
-        const auto& t = comp.get_type(outRes.type_id);
-        InputAttributeInfo ao{};
-        ao.location = comp.get_decoration(outRes.id, spv::DecorationLocation);
-        ao.name     = comp.get_name(outRes.id);
-        if (ao.name.empty())
-            ao.name = comp.get_fallback_name(outRes.id);
-        ao.vecSize  = t.vecsize;
-        ao.bitWidth = t.width;
-        reflection.outputs.push_back(std::move(ao));
-    }
-
-    return reflection;
-}
+/*
+* File: shader_pipe
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/2/2025
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_pipe.hpp"
+#include "shader_compiler.hpp"
+#include "shader_pipe_internal.hpp"
+#include "shader_trace_internal.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include <vulkan/vulkan.h>
+#include <glslang/Public/ShaderLang.h>
+#include <SPIRV/GlslangToSpv.h>
+#include <glslang/Include/ResourceLimits.h>
+#include <spirv_cross.hpp>
+#include <spirv_glsl.hpp>
+
+const TBuiltInResource DefaultTBuiltInResource = {
+    /* .MaxLights = */ 32,
+    /* .MaxClipPlanes = */ 6,
+    /* .MaxTextureUnits = */ 32,
+    /* .MaxTextureCoords = */ 32,
+    /* .MaxVertexAttribs = */ 64,
+    /* .MaxVertexUniformComponents = */ 4096,
+    /* .MaxVaryingFloats = */ 64,
+    /* .MaxVertexTextureImageUnits = */ 32,
+    /* .MaxCombinedTextureImageUnits = */ 80,
+    /* .MaxTextureImageUnits = */ 32,
+    /* .MaxFragmentUniformComponents = */ 4096,
+    /* .MaxDrawBuffers = */ 32,
+    /* .MaxVertexUniformVectors = */ 128,
+    /* .MaxVaryingVectors = */ 8,
+    /* .MaxFragmentUniformVectors = */ 16,
+    /* .MaxVertexOutputVectors = */ 16,
+    /* .MaxFragmentInputVectors = */ 15,
+    /* .MinProgramTexelOffset = */ -8,
+    /* .MaxProgramTexelOffset = */ 7,
+    /* .MaxClipDistances = */ 8,
+    /* .MaxComputeWorkGroupCountX = */ 65535,
+    /* .MaxComputeWorkGroupCountY = */ 65535,
+    /* .MaxComputeWorkGroupCountZ = */ 65535,
+    /* .MaxComputeWorkGroupSizeX = */ 1024,
+    /* .MaxComputeWorkGroupSizeY = */ 1024,
+    /* .MaxComputeWorkGroupSizeZ = */ 64,
+    /* .MaxComputeUniformComponents = */ 1024,
+    /* .MaxComputeTextureImageUnits = */ 16,
+    /* .MaxComputeImageUniforms = */ 8,
+    /* .MaxComputeAtomicCounters = */ 8,
+    /* .MaxComputeAtomicCounterBuffers = */ 1,
+    /* .MaxVaryingComponents = */ 60,
+    /* .MaxVertexOutputComponents = */ 64,
+    /* .MaxGeometryInputComponents = */ 64,
+    /* .MaxGeometryOutputComponents = */ 128,
+    /* .MaxFragmentInputComponents = */ 128,
+    /* .MaxImageUnits = */ 8,
+    /* .MaxCombinedImageUnitsAndFragmentOutputs = */ 8,
+    /* .MaxCombinedShaderOutputResources = */ 8,
+    /* .MaxImageSamples = */ 0,
+    /* .MaxVertexImageUniforms = */ 0,
+    /* .MaxTessControlImageUniforms = */ 0,
+    /* .MaxTessEvaluationImageUniforms = */ 0,
+    /* .MaxGeometryImageUniforms = */ 0,
+    /* .MaxFragmentImageUniforms = */ 8,
+    /* .MaxCombinedImageUniforms = */ 8,
+    /* .MaxGeometryTextureImageUnits = */ 16,
+    /* .MaxGeometryOutputVertices = */ 256,
+    /* .MaxGeometryTotalOutputComponents = */ 1024,
+    /* .MaxGeometryUniformComponents = */ 1024,
+    /* .MaxGeometryVaryingComponents = */ 64,
+    /* .MaxTessControlInputComponents = */ 128,
+    /* .MaxTessControlOutputComponents = */ 128,
+    /* .MaxTessControlTextureImageUnits = */ 16,
+    /* .MaxTessControlUniformComponents = */ 1024,
+    /* .MaxTessControlTotalOutputComponents = */ 4096,
+    /* .MaxTessEvaluationInputComponents = */ 128,
+    /* .MaxTessEvaluationOutputComponents = */ 128,
+    /* .MaxTessEvaluationTextureImageUnits = */ 16,
+    /* .MaxTessEvaluationUniformComponents = */ 1024,
+    /* .MaxTessPatchComponents = */ 120,
+    /* .MaxPatchVertices = */ 32,
+    /* .MaxTessGenLevel = */ 64,
+    /* .MaxViewports = */ 16,
+    /* .MaxVertexAtomicCounters = */ 0,
+    /* .MaxTessControlAtomicCounters = */ 0,
+    /* .MaxTessEvaluationAtomicCounters = */ 0,
+    /* .MaxGeometryAtomicCounters = */ 0,
+    /* .MaxFragmentAtomicCounters = */ 8,
+    /* .MaxCombinedAtomicCounters = */ 8,
+    /* .MaxAtomicCounterBindings = */ 1,
+    /* .MaxVertexAtomicCounterBuffers = */ 0,
+    /* .MaxTessControlAtomicCounterBuffers = */ 0,
+    /* .MaxTessEvaluationAtomicCounterBuffers = */ 0,
+    /* .MaxGeometryAtomicCounterBuffers = */ 0,
+    /* .MaxFragmentAtomicCounterBuffers = */ 1,
+    /* .MaxCombinedAtomicCounterBuffers = */ 1,
+    /* .MaxAtomicCounterBufferSize = */ 16384,
+    /* .MaxTransformFeedbackBuffers = */ 4,
+    /* .MaxTransformFeedbackInterleavedComponents = */ 64,
+    /* .MaxCullDistances = */ 8,
+    /* .MaxCombinedClipAndCullDistances = */ 8,
+    /* .MaxSamples = */ 4,
+    /* .maxMeshOutputVerticesNV = */ 256,
+    /* .maxMeshOutputPrimitivesNV = */ 512,
+    /* .maxMeshWorkGroupSizeX_NV = */ 32,
+    /* .maxMeshWorkGroupSizeY_NV = */ 1,
+    /* .maxMeshWorkGroupSizeZ_NV = */ 1,
+    /* .maxTaskWorkGroupSizeX_NV = */ 32,
+    /* .maxTaskWorkGroupSizeY_NV = */ 1,
+    /* .maxTaskWorkGroupSizeZ_NV = */ 1,
+    /* .maxMeshViewCountNV = */ 4,
+    /* .maxMeshOutputVerticesEXT = */ 256,
+    /* .maxMeshOutputPrimitivesEXT = */ 256,
+    /* .maxMeshWorkGroupSizeX_EXT = */ 128,
+    /* .maxMeshWorkGroupSizeY_EXT = */ 128,
+    /* .maxMeshWorkGroupSizeZ_EXT = */ 128,
+    /* .maxTaskWorkGroupSizeX_EXT = */ 128,
+    /* .maxTaskWorkGroupSizeY_EXT = */ 128,
+    /* .maxTaskWorkGroupSizeZ_EXT = */ 128,
+    /* .maxMeshViewCountEXT = */ 4,
+    /* .maxDualSourceDrawBuffersEXT = */ 1,
+
+    /* .limits = */ {
+        /* .nonInductiveForLoops = */ 1,
+        /* .whileLoops = */ 1,
+        /* .doWhileLoops = */ 1,
+        /* .generalUniformIndexing = */ 1,
+        /* .generalAttributeMatrixVectorIndexing = */ 1,
+        /* .generalVaryingIndexing = */ 1,
+        /* .generalSamplerIndexing = */ 1,
+        /* .generalVariableIndexing = */ 1,
+        /* .generalConstantMatrixVectorIndexing = */ 1,
+    }};
+
+namespace shaderpipe {
+
+static VkShaderStageFlagBits exec_model_to_stage(spirv_cross::ExecutionModel m) {
+    switch (m) {
+    case spv::ExecutionModelVertex: return VK_SHADER_STAGE_VERTEX_BIT;
+    case spv::ExecutionModelTessellationControl: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+    case spv::ExecutionModelTessellationEvaluation: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+    case spv::ExecutionModelGeometry: return VK_SHADER_STAGE_GEOMETRY_BIT;
+    case spv::ExecutionModelFragment: return VK_SHADER_STAGE_FRAGMENT_BIT;
+    case spv::ExecutionModelGLCompute: return VK_SHADER_STAGE_COMPUTE_BIT;
+    case spv::ExecutionModelRayGenerationKHR: return VK_SHADER_STAGE_RAYGEN_BIT_KHR;
+    case spv::ExecutionModelIntersectionKHR: return VK_SHADER_STAGE_INTERSECTION_BIT_KHR;
+    case spv::ExecutionModelAnyHitKHR: return VK_SHADER_STAGE_ANY_HIT_BIT_KHR;
+    case spv::ExecutionModelClosestHitKHR: return VK_SHADER_STAGE_CLOSEST_HIT_BIT_KHR;
+    case spv::ExecutionModelMissKHR: return VK_SHADER_STAGE_MISS_BIT_KHR;
+    case spv::ExecutionModelCallableKHR: return VK_SHADER_STAGE_CALLABLE_BIT_KHR;
+    case spv::ExecutionModelTaskEXT: return VK_SHADER_STAGE_TASK_BIT_EXT;
+    case spv::ExecutionModelMeshEXT: return VK_SHADER_STAGE_MESH_BIT_EXT;
+    default: return static_cast<VkShaderStageFlagBits>(0);
+    }
+}
+
+EShLanguage shader_stage_to_glslang (ShaderStage s) {
+    switch (s) {
+    default: case ShaderStage::VERTEX: return EShLangVertex;
+    case ShaderStage::TESS_CONTROL: return EShLangTessControl;
+    case ShaderStage::TESS_EVAL: return EShLangTessEvaluation;
+    case ShaderStage::GEOMETRY: return EShLangGeometry;
+    case ShaderStage::FRAGMENT: return EShLangFragment;
+    case ShaderStage::COMPUTE: return EShLangCompute;
+    case ShaderStage::RAYGEN: return EShLangRayGen;
+    case ShaderStage::INTERSECT: return EShLangIntersect;
+    case ShaderStage::ANY_HIT: return EShLangAnyHit;
+    case ShaderStage::CLOSEST_HIT: return EShLangClosestHit;
+    case ShaderStage::MISS: return EShLangMiss;
+    case ShaderStage::CALLABLE: return EShLangCallable;
+    case ShaderStage::TASK: return EShLangTask;
+    case ShaderStage::MESH: return EShLangMesh;
+    }  // not sure what else to default to
+};
+
+static uint32_t gl_version_enum_to_int (GlVersion v) {
+    switch (v) {
+    case GlVersion::GL_310: return 310;
+    case GlVersion::GL_330: return 330;
+    default: case GlVersion::GL_450: return 450;
+        // Maybe default should be 310
+    }
+};
+
+glslang::EShTargetClientVersion vk_version_to_glslang(VKVersion v) {
+    switch (v) {
+    case VKVersion::VK_1_0: return glslang::EShTargetVulkan_1_0;
+    case VKVersion::VK_1_1: return glslang::EShTargetVulkan_1_1;
+    case VKVersion::VK_1_2: return glslang::EShTargetVulkan_1_2;
+    case VKVersion::VK_1_3: return glslang::EShTargetVulkan_1_3;
+    case VKVersion::VK_1_4: return glslang::EShTargetVulkan_1_4;
+    }
+    return glslang::EShTargetVulkan_1_0;
+}
+
+glslang::EShTargetLanguageVersion vk_version_to_spirv_version(VKVersion v) {
+    switch (v) {
+    case VKVersion::VK_1_0: return glslang::EShTargetSpv_1_0;
+    case VKVersion::VK_1_1: return glslang::EShTargetSpv_1_3;
+    case VKVersion::VK_1_2: return glslang::EShTargetSpv_1_5;
+    case VKVersion::VK_1_3:
+    case VKVersion::VK_1_4:
+        return glslang::EShTargetSpv_1_6; // TODO: may need to handle compatability for spv 1.5
+    }
+    return glslang::EShTargetSpv_1_0;
+}
+
+static ScalarType scalar_type(const spirv_cross::SPIRType& type) {
+    switch (type.basetype) {
+        case spirv_cross::SPIRType::Boolean: return ScalarType::BOOL;
+        case spirv_cross::SPIRType::SByte:
+        case spirv_cross::SPIRType::Short:
+        case spirv_cross::SPIRType::Int:
+        case spirv_cross::SPIRType::Int64: return ScalarType::INT;
+        case spirv_cross::SPIRType::Half:
+        case spirv_cross::SPIRType::Float:
+        case spirv_cross::SPIRType::Double: return ScalarType::FLOAT;
+        default: return ScalarType::UINT;
+    }
+}
+
+static InputAttributeInfo attribute_from_resource(const spirv_cross::Compiler& comp, const spirv_cross::Resource& res) {
+    const auto& t = comp.get_type(res.type_id);
+    InputAttributeInfo info{};
+    info.location = comp.get_decoration(res.id, spv::DecorationLocation);
+    info.name     = comp.get_name(res.id);
+    if (info.name.empty())
+        info.name = comp.get_fallback_name(res.id);
+    info.vecSize  = t.vecsize;
+    info.bitWidth = t.width;
+    info.baseType = scalar_type(t);
+    info.columns  = t.columns;
+    info.arraySize = 1;
+    for (size_t i = 0; i < t.array.size(); ++i) {
+        // Tessellation and geometry inputs are per-vertex arrays, their outer dimension is counted here as well.
+        if (t.array_size_literal.size() > i && t.array_size_literal[i] && t.array[i] > 0)
+            info.arraySize *= t.array[i];
+    }
+    return info;
+}
+
+static uint32_t descriptor_count_from_type(const spirv_cross::Compiler& comp, const spirv_cross::SPIRType& type) {
+    // No array => single descriptor
+    if (type.array.empty())
+        return 1;
+
+    uint32_t total = 1;
+
+    // Each dimension can be:
+    //  - a literal (array_size_literal[i] == true)  => use that value
+    //  - a specialization constant                  => its default value
+    //  - a runtime array (size 0)                   => treat as 1 for descriptor count
+    for (size_t i = 0; i < type.array.size(); ++i)
+    {
+        uint32_t dim = 1;
+
+        if (type.array_size_literal.size() > i && type.array_size_literal[i])
+        {
+            // Literal size directly in the SPIR-V
+            dim = type.array[i];
+        }
+        else
+        {
+            // Sized by a specialization constant, array[i] is the constant's id. Use its default value, the count
+            // the pipeline actually gets is only known once the module is specialized (see specialize_spirv).
+            // An OpSpecConstantOp expression can not be evaluated through spirv-cross' public API, those stay 1.
+            const uint32_t id = type.array[i];
+            if (id < comp.get_ir().ids.size() && comp.get_ir().ids[id].get_type() == spirv_cross::TypeConstant)
+                dim = comp.get_constant(id).scalar();
+        }
+
+        // Runtime arrays sometimes come through as 0. Clamp to 1 for descriptor count.
+        if (dim == 0)
+            dim = 1;
+
+        total *= dim;
+    }
+
+    return total == 0 ? 1u : total;
+}
+
+static void add_descriptor_from_resource(std::vector<DescriptorBindingInfo>& out,
+                                         const spirv_cross::Compiler& comp,
+                                         const spirv_cross::Resource& res,
+                                         VkDescriptorType dtype,
+                                         VkShaderStageFlags stageFlags)
+{
+    const auto& type = comp.get_type(res.type_id);
+    DescriptorBindingInfo info{};
+    info.set    = comp.get_decoration(res.id, spv::DecorationDescriptorSet);
+    info.binding= comp.get_decoration(res.id, spv::DecorationBinding);
+    info.name   = comp.get_name(res.id);
+    if (info.name.empty())
+        info.name = comp.get_fallback_name(res.id);
+    info.type   = dtype;
+    info.count  = descriptor_count_from_type(comp, type);
+    info.stageFlags = stageFlags;
+    out.push_back(std::move(info));
+}
+
+uint32_t get_glsl_version(std::string_view source) {
+    static constexpr std::string_view directive = "#version";
+
+    std::size_t pos = source.find(directive);
+    if (pos == std::string_view::npos)
+        return 0;
+
+    // Parsed in place, no line copy / stream. The profile can be safely ignored for now.
+    std::string_view rest = source.substr(pos + directive.size());
+    std::size_t begin = rest.find_first_not_of(" \t");
+    if (begin == std::string_view::npos)
+        return 0;
+
+    uint32_t version = 0;
+    auto [ptr, ec] = std::from_chars(rest.data() + begin, rest.data() + rest.size(), version);
+    return ec == std::errc() ? version : 0;
+}
+
+std::string load_shader_file(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Shader file could not be opened.");
+    }
+
+    // Pipes and other streams that can not seek have no size up front, read them through a buffer instead.
+    // (Not opened with ios::ate, that fails the open itself on such streams.)
+    file.seekg(0, std::ios::end);
+    const auto size = static_cast<std::streamsize>(file.tellg());
+    if (size < 0) {
+        file.clear();
+        std::ostringstream streamed;
+        streamed << file.rdbuf();
+        return std::move(streamed).str();
+    }
+
+    // Read straight into the result, one copy total.
+    std::string contents(static_cast<size_t>(size), '\0');
+    file.seekg(0);
+    file.read(contents.data(), size);
+    if (file.gcount() != size) {
+        throw std::runtime_error("Shader file could not be read completely.");
+    }
+
+    return contents;
+}
+
+std::vector<uint32_t> glsl_to_spirv(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion) {
+    return default_compiler().glsl_to_spirv(source, stage, targetVulkanVersion);
+}
+
+CompiledShader glsl_to_spirv_with_reflection(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion) {
+    return default_compiler().glsl_to_spirv_with_reflection(source, stage, targetVulkanVersion);
+}
+
+spirv_cross::CompilerGLSL::Options glsl_options(GlVersion version) {
+    // Options for GLSL output
+    spirv_cross::CompilerGLSL::Options options;
+    options.version = gl_version_enum_to_int(version);
+    options.es = (version == GlVersion::GL_310); // SPIRV-Cross emits the default precision statements ES needs
+    options.vulkan_semantics = false;
+    options.separate_shader_objects = false;
+    options.enable_420pack_extension = !options.es && version != GlVersion::GL_450; // TODO: If GL versions are extended, this line will need to be altered to properly handle more than one version that doesn't need the extension.
+    return options;
+}
+
+std::string cross_compile_glsl(spirv_cross::CompilerGLSL& compiler, GlVersion version) {
+    compiler.set_common_options(glsl_options(version));
+
+    return compiler.compile();
+}
+
+std::string spirv_to_glsl (std::span<const uint32_t> source, GlVersion version) {
+    CompileTrace trace("spirv_to_glsl");
+    trace.set_spirv_words(source.size());
+
+    TraceScope scope(TracePhase::CROSS_COMPILE);
+    spirv_cross::CompilerGLSL compiler(source.data(), source.size());
+    auto glsl = cross_compile_glsl(compiler, version);
+    trace.succeeded();
+    return glsl;
+}
+
+SHADERPIPE_API ShaderReflection reflect_spirv (std::span<const uint32_t> source, const ReflectionOptions& options) {
+    CompileTrace trace("reflect_spirv");
+
+    TraceScope scope(TracePhase::REFLECT);
+    spirv_cross::Compiler comp(source.data(), source.size());
+    auto reflection = reflect_compiler(comp, options);
+    trace.succeeded();
+    return reflection;
+}
+
+ShaderReflection reflect_compiler(const spirv_cross::Compiler& comp, const ReflectionOptions& options) {
+    ShaderReflection reflection{};
+
+    // Determine stage flags from execution model.
+    auto stageBit = exec_model_to_stage(comp.get_execution_model());
+    VkShaderStageFlags stageFlags = stageBit ? (VkShaderStageFlags)stageBit : 0;
+
+    // Query all resources.
+    spirv_cross::ShaderResources res = comp.get_shader_resources();
+
+    // Variables some instruction reachable from the entry point reads or writes, everything else is only declared.
+    std::unordered_set<spirv_cross::VariableID> active;
+    if (options.activeOnly)
+        active = comp.get_active_interface_variables();
+    const auto is_active = [&](const spirv_cross::Resource& r) { return !options.activeOnly || active.count(r.id) != 0; };
+    const auto add_descriptor = [&](const spirv_cross::Resource& r, VkDescriptorType dtype) {
+        add_descriptor_from_resource(is_active(r) ? reflection.descriptorBindings : reflection.unusedDescriptorBindings,
+                                     comp, r, dtype, stageFlags);
+    };
+
+    // Descriptors
+    for (auto& ubo : res.uniform_buffers) {
+        add_descriptor(ubo, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    }
+    for (auto& ssbo : res.storage_buffers) {
+        add_descriptor(ssbo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    }
+    for (auto& img : res.sampled_images) {
+        // Combined image-sampler
+        add_descriptor(img, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    }
+    for (auto& img : res.separate_images) {
+        add_descriptor(img, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+    }
+    for (auto& smp : res.separate_samplers) {
+        add_descriptor(smp, VK_DESCRIPTOR_TYPE_SAMPLER);
+    }
+    for (auto& img : res.storage_images) {
+        add_descriptor(img, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE);
+    }
+    for (auto& inAtt : res.subpass_inputs) {
+        add_descriptor(inAtt, VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
+    }
+#ifdef VK_KHR_acceleration_structure
+    for (auto& as : res.acceleration_structures) {
+        add_descriptor(as, VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR);
+    }
+#endif
+
+    // Push Constants
+    for (auto& pcb : res.push_constant_buffers) {
+        // Only report the bytes this entry point actually reads, so stages sharing one block can each
+        // declare a tight range instead of all of them claiming the whole struct.
+        const auto ranges = comp.get_active_buffer_ranges(pcb.id);
+        if (ranges.empty() && options.activeOnly)
+            continue;
+
+        PushConstantInfo pci{};
+        if (ranges.empty()) {
+            // Declared but never touched, keep the declared size so the layout still covers the block.
+            const auto& type = comp.get_type(pcb.base_type_id);
+            pci.offset = 0;
+            pci.size   = static_cast<uint32_t>(comp.get_declared_struct_size(type));
+        } else {
+            size_t begin = SIZE_MAX, end = 0;
+            for (const auto& range : ranges) {
+                begin = std::min(begin, range.offset);
+                end   = std::max(end, range.offset + range.range);
+            }
+            // Vulkan wants push constant offsets and sizes in multiples of 4 (16 bit members can break that).
+            begin &= ~size_t(3);
+            end    = (end + 3) & ~size_t(3);
+            pci.offset = static_cast<uint32_t>(begin);
+            pci.size   = static_cast<uint32_t>(end - begin);
+        }
+        pci.stageFlags = stageFlags;
+        reflection.pushConstants.push_back(pci);
+    }
+
+    // Stage Inputs
+    for (auto& in : res.stage_inputs) {
+        if (is_active(in))
+            reflection.inputs.push_back(attribute_from_resource(comp, in));
+    }
+
+    // Stage Outputs
+    for (auto& outRes : res.stage_outputs) {
+        if (is_active(outRes))
+            reflection.outputs.push_back(attribute_from_resource(comp, outRes));
+    }
+
+    // Specialization constants
+    for (const auto& sc : comp.get_specialization_constants()) {
+        const auto& constant = comp.get_constant(sc.id);
+        const auto& t = comp.get_type(constant.constant_type);
+
+        SpecConstantInfo info{};
+        info.constantId = sc.constant_id;
+        info.name = comp.get_name(sc.id);
+        if (info.name.empty())
+            info.name = comp.get_fallback_name(sc.id);
+        info.bitWidth = t.width;
+        info.type = scalar_type(t);
+        info.defaultValue = t.width > 32 ? constant.scalar_u64() : constant.scalar();
+        // Signed integers sign extended to 64 bits, the same bits SpecConstantValue::from_int produces.
+        if (info.type == ScalarType::INT && t.width < 64) {
+            const uint32_t shift = 64 - t.width;
+            info.defaultValue = static_cast<uint64_t>(static_cast<int64_t>(info.defaultValue << shift) >> shift);
+        }
+        reflection.specConstants.push_back(std::move(info));
+    }
+
+    return reflection;
+}
 }
\ No newline at end of file
@@ -0,0 +1,42 @@
+/*
+* File: shader_pipe_internal
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+// Helpers shared between the library translation units. Not installed / not part of the public API.
+
+#ifndef SHADER_PIPE_SHADER_PIPE_INTERNAL_HPP
+#define SHADER_PIPE_SHADER_PIPE_INTERNAL_HPP
+
+#include "shader_pipe.hpp"
+
+#include <glslang/Public/ShaderLang.h>
+#include <glslang/Include/ResourceLimits.h>
+#include <spirv_cross.hpp>
+#include <spirv_glsl.hpp>
+
+extern const TBuiltInResource DefaultTBuiltInResource;
+
+namespace shaderpipe {
+
+EShLanguage                       shader_stage_to_glslang     (ShaderStage s);
+glslang::EShTargetClientVersion   vk_version_to_glslang       (VKVersion v);
+glslang::EShTargetLanguageVersion vk_version_to_spirv_version (VKVersion v);
+
+// Reflection / cross compilation on an already parsed module, so callers holding a ParsedIR skip the parse.
+ShaderReflection reflect_compiler   (const spirv_cross::Compiler& comp, const ReflectionOptions& options = {});
+std::string      cross_compile_glsl (spirv_cross::CompilerGLSL& compiler, GlVersion version);
+
+// What cross_compile_glsl sets for version, for callers that adjust a few options before compiling.
+spirv_cross::CompilerGLSL::Options glsl_options(GlVersion version);
+
+}
+
+#endif //SHADER_PIPE_SHADER_PIPE_INTERNAL_HPP
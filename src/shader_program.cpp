@@ -0,0 +1,127 @@
+/*
+* File: shader_program
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_program.hpp"
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+namespace shaderpipe {
+
+struct StageRange {
+    uint32_t begin;
+    uint32_t end;
+};
+
+static void merge_binding(DescriptorBindingInfo& merged, const DescriptorBindingInfo& binding) {
+    if (merged.type != binding.type || merged.count != binding.count) {
+        throw std::runtime_error(
+            "Descriptor set " + std::to_string(binding.set) + ", binding " + std::to_string(binding.binding) +
+            " is declared differently by two stages ('" + merged.name + "' type " + std::to_string(merged.type) +
+            " count " + std::to_string(merged.count) + " vs '" + binding.name + "' type " +
+            std::to_string(binding.type) + " count " + std::to_string(binding.count) + ").");
+    }
+    merged.stageFlags |= binding.stageFlags;
+}
+
+ShaderHash hash_set_layout(std::span<const DescriptorBindingInfo> bindings) {
+    std::vector<const DescriptorBindingInfo*> sorted;
+    sorted.reserve(bindings.size());
+    for (const auto& b : bindings)
+        sorted.push_back(&b);
+    std::sort(sorted.begin(), sorted.end(), [](auto* a, auto* b) { return a->binding < b->binding; });
+
+    Hasher hasher;
+    hasher.update("shaderpipe-set-layout");
+    hasher.update_value(static_cast<uint32_t>(sorted.size()));
+    for (const auto* b : sorted) {
+        // Field by field with fixed widths, the struct itself has padding and a std::string in it.
+        hasher.update_value(b->binding);
+        hasher.update_value(static_cast<uint32_t>(b->type));
+        hasher.update_value(b->count);
+        hasher.update_value(static_cast<uint32_t>(b->stageFlags));
+    }
+    return hasher.finish();
+}
+
+template<typename T, typename GetReflection>
+static ProgramReflection merge_stages(std::span<const T> stages, GetReflection get_reflection) {
+    ProgramReflection program;
+
+    std::map<uint32_t, std::map<uint32_t, DescriptorBindingInfo>> sets;
+    std::map<VkShaderStageFlagBits, StageRange> stageRanges;
+
+    for (const auto& item : stages) {
+        const ShaderReflection& stage = get_reflection(item);
+        for (const auto& binding : stage.descriptorBindings) {
+            program.stages |= binding.stageFlags;
+            auto& bindings = sets[binding.set];
+            if (auto it = bindings.find(binding.binding); it != bindings.end())
+                merge_binding(it->second, binding);
+            else
+                bindings.emplace(binding.binding, binding);
+        }
+
+        for (const auto& pc : stage.pushConstants) {
+            program.stages |= pc.stageFlags;
+            // Vulkan allows each stage in at most one range, so grow the stage's range to cover everything it reads.
+            for (uint32_t bit = 0; bit < 32; ++bit) {
+                const auto flag = static_cast<VkShaderStageFlagBits>(1u << bit);
+                if (!(pc.stageFlags & flag))
+                    continue;
+                auto [it, inserted] = stageRanges.try_emplace(flag, StageRange{ pc.offset, pc.offset + pc.size });
+                if (!inserted) {
+                    it->second.begin = std::min(it->second.begin, pc.offset);
+                    it->second.end   = std::max(it->second.end, pc.offset + pc.size);
+                }
+            }
+        }
+    }
+
+    program.setLayouts.reserve(sets.size());
+    for (auto& [set, bindings] : sets) {
+        DescriptorSetLayoutInfo layout;
+        layout.set = set;
+        layout.bindings.reserve(bindings.size());
+        for (auto& [index, binding] : bindings)
+            layout.bindings.push_back(std::move(binding));
+        layout.hash = hash_set_layout(layout.bindings);
+        program.setLayouts.push_back(std::move(layout));
+    }
+
+    // Stages that read exactly the same bytes share one range.
+    for (const auto& [flag, range] : stageRanges) {
+        auto it = std::find_if(program.pushConstants.begin(), program.pushConstants.end(), [&](const PushConstantInfo& pc) {
+            return pc.offset == range.begin && pc.size == range.end - range.begin;
+        });
+        if (it != program.pushConstants.end())
+            it->stageFlags |= flag;
+        else
+            program.pushConstants.push_back({ range.begin, range.end - range.begin, static_cast<VkShaderStageFlags>(flag) });
+    }
+    std::sort(program.pushConstants.begin(), program.pushConstants.end(), [](const PushConstantInfo& a, const PushConstantInfo& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.size < b.size;
+    });
+
+    return program;
+}
+
+ProgramReflection reflect_program(std::span<const ShaderReflection> stages) {
+    return merge_stages(stages, [](const ShaderReflection& r) -> const ShaderReflection& { return r; });
+}
+
+ProgramReflection reflect_program(std::span<const CompiledShader> stages) {
+    return merge_stages(stages, [](const CompiledShader& s) -> const ShaderReflection& { return s.reflection; });
+}
+}
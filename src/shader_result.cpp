@@ -0,0 +1,199 @@
+/*
+* File: shader_result
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_result.hpp"
+#include "shader_compiler.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace shaderpipe {
+
+const char* status_code_name(StatusCode code) {
+    switch (code) {
+    case StatusCode::OK:                   return "ok";
+    case StatusCode::PREPROCESS_FAILED:    return "preprocess failed";
+    case StatusCode::COMPILE_FAILED:       return "compile failed";
+    case StatusCode::LINK_FAILED:          return "link failed";
+    case StatusCode::OPTIMIZE_FAILED:      return "optimize failed";
+    case StatusCode::INVALID_SPIRV:        return "invalid SPIR-V";
+    case StatusCode::CROSS_COMPILE_FAILED: return "cross compile failed";
+    case StatusCode::CANCELLED:            return "cancelled";
+    case StatusCode::INTERNAL_ERROR:       return "internal error";
+    }
+    return "unknown";
+}
+
+static bool starts_with(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
+}
+
+// Digits up to the next ':', consumed from rest on success.
+static bool take_number(std::string_view& rest, uint32_t& value) {
+    const auto colon = rest.find(':');
+    if (colon == 0 || colon == std::string_view::npos)
+        return false;
+    const auto [end, ec] = std::from_chars(rest.data(), rest.data() + colon, value);
+    if (ec != std::errc() || end != rest.data() + colon)
+        return false;
+    rest.remove_prefix(colon + 1);
+    return true;
+}
+
+static std::string_view trim(std::string_view str) {
+    while (!str.empty() && str.front() == ' ')
+        str.remove_prefix(1);
+    while (!str.empty() && str.back() == ' ')
+        str.remove_suffix(1);
+    return str;
+}
+
+// "<file>:<line>[:<column>]: <message>". The file is everything up to the first ':' that is followed by a line
+// number, so drive letters and other colons in paths survive.
+static Diagnostic parse_line(DiagnosticSeverity severity, std::string_view body) {
+    for (size_t colon = body.find(':'); colon != std::string_view::npos; colon = body.find(':', colon + 1)) {
+        auto rest = body.substr(colon + 1);
+        uint32_t line = 0;
+        if (!take_number(rest, line))
+            continue;
+        uint32_t column = 0;
+        if (auto afterColumn = rest; take_number(afterColumn, column))
+            rest = afterColumn;
+        return { severity, body.substr(0, colon), line, column, trim(rest) };
+    }
+    return { severity, {}, 0, 0, trim(body) };
+}
+
+DiagnosticBuffer::DiagnosticBuffer(const DiagnosticBuffer& other) {
+    *this = other;
+}
+
+DiagnosticBuffer::DiagnosticBuffer(DiagnosticBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+DiagnosticBuffer& DiagnosticBuffer::operator=(const DiagnosticBuffer& other) {
+    if (this != &other) {
+        text = other.text;
+        entries = other.entries;
+        rebase(other.text.data());
+    }
+    return *this;
+}
+
+DiagnosticBuffer& DiagnosticBuffer::operator=(DiagnosticBuffer&& other) noexcept {
+    if (this != &other) {
+        const char* oldText = other.text.data(); // short strings live inside the object and do move
+        text = std::move(other.text);
+        entries = std::move(other.entries);
+        rebase(oldText);
+        other.clear();
+    }
+    return *this;
+}
+
+void DiagnosticBuffer::rebase(const char* oldText) {
+    auto fix = [&](std::string_view& view) {
+        if (!view.empty())
+            view = { text.data() + (view.data() - oldText), view.size() };
+    };
+    for (auto& entry : entries) {
+        fix(entry.file);
+        fix(entry.message);
+    }
+}
+
+size_t DiagnosticBuffer::error_count() const {
+    return static_cast<size_t>(std::count_if(entries.begin(), entries.end(),
+                                             [](const Diagnostic& d) { return d.severity == DiagnosticSeverity::ERROR; }));
+}
+
+void DiagnosticBuffer::clear() {
+    text.clear();
+    entries.clear();
+}
+
+void DiagnosticBuffer::set_log(std::string_view log) {
+    text.assign(log);
+    entries.clear();
+
+    std::string_view rest = text;
+    while (!rest.empty()) {
+        const auto newline = rest.find('\n');
+        auto line = rest.substr(0, newline);
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+
+        if (starts_with(line, "ERROR: ") || starts_with(line, "INTERNAL ERROR: ")) {
+            auto body = line.substr(line.find(": ") + 2);
+            // "ERROR: 2 compilation errors.  No code generated." only repeats what came before.
+            if (body.find("compilation errors") != std::string_view::npos && body.find(':') == std::string_view::npos)
+                continue;
+            entries.push_back(parse_line(DiagnosticSeverity::ERROR, body));
+        } else if (starts_with(line, "WARNING: ")) {
+            entries.push_back(parse_line(DiagnosticSeverity::WARNING, line.substr(9)));
+        } else if (starts_with(line, "NOTE: ")) {
+            entries.push_back(parse_line(DiagnosticSeverity::NOTE, line.substr(6)));
+        } else {
+            entries.push_back({ DiagnosticSeverity::NOTE, {}, 0, 0, line });
+        }
+    }
+}
+
+void DiagnosticBuffer::set_error(std::string_view message) noexcept {
+    clear();
+    try {
+        text.assign(message);
+        entries.push_back({ DiagnosticSeverity::ERROR, {}, 0, 0, text });
+    } catch (...) {
+        clear();
+    }
+}
+
+Result<CompiledShader> try_glsl_to_spirv_with_reflection(std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                                         DiagnosticBuffer& diagnostics) noexcept {
+    return default_compiler().try_glsl_to_spirv_with_reflection(source, stage, targetVulkanVersion, diagnostics);
+}
+
+// SPIRV-Cross only reports errors by throwing, so these two still unwind internally. Unlike shader errors,
+// a module that fails to parse means a bug upstream, not something that happens on every keystroke.
+Result<ShaderReflection> try_reflect_spirv(std::span<const uint32_t> source, DiagnosticBuffer& diagnostics, const ReflectionOptions& options) noexcept {
+    try {
+        auto reflection = reflect_spirv(source, options);
+        diagnostics.clear();
+        return reflection;
+    } catch (const std::exception& e) {
+        diagnostics.set_error(e.what());
+        return StatusCode::INVALID_SPIRV;
+    } catch (...) {
+        diagnostics.set_error("Unknown error.");
+        return StatusCode::INTERNAL_ERROR;
+    }
+}
+
+Result<std::string> try_spirv_to_glsl(std::span<const uint32_t> source, DiagnosticBuffer& diagnostics, GlVersion version) noexcept {
+    try {
+        auto glsl = spirv_to_glsl(source, version);
+        diagnostics.clear();
+        return glsl;
+    } catch (const std::exception& e) {
+        diagnostics.set_error(e.what());
+        return StatusCode::CROSS_COMPILE_FAILED;
+    } catch (...) {
+        diagnostics.set_error("Unknown error.");
+        return StatusCode::INTERNAL_ERROR;
+    }
+}
+}
@@ -0,0 +1,363 @@
+/*
+* File: shader_scanner
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_scanner.hpp"
+#include "shader_dependency_graph.hpp"
+#include "shader_thread_pool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+namespace {
+struct StageName {
+    std::string_view name;
+    ShaderStage stage;
+};
+
+constexpr StageName StageExtensions[] = {
+    { ".vert",  ShaderStage::VERTEX },
+    { ".tesc",  ShaderStage::TESS_CONTROL },
+    { ".tese",  ShaderStage::TESS_EVAL },
+    { ".geom",  ShaderStage::GEOMETRY },
+    { ".frag",  ShaderStage::FRAGMENT },
+    { ".comp",  ShaderStage::COMPUTE },
+    { ".rgen",  ShaderStage::RAYGEN },
+    { ".rint",  ShaderStage::INTERSECT },
+    { ".rahit", ShaderStage::ANY_HIT },
+    { ".rchit", ShaderStage::CLOSEST_HIT },
+    { ".rmiss", ShaderStage::MISS },
+    { ".rcall", ShaderStage::CALLABLE },
+    { ".task",  ShaderStage::TASK },
+    { ".mesh",  ShaderStage::MESH },
+};
+
+// #pragma shader_stage(...) names, as shaderc spells them.
+constexpr StageName StagePragmas[] = {
+    { "vertex",       ShaderStage::VERTEX },
+    { "tesscontrol",  ShaderStage::TESS_CONTROL },
+    { "tesseval",     ShaderStage::TESS_EVAL },
+    { "geometry",     ShaderStage::GEOMETRY },
+    { "fragment",     ShaderStage::FRAGMENT },
+    { "compute",      ShaderStage::COMPUTE },
+    { "raygen",       ShaderStage::RAYGEN },
+    { "intersection", ShaderStage::INTERSECT },
+    { "anyhit",       ShaderStage::ANY_HIT },
+    { "closesthit",   ShaderStage::CLOSEST_HIT },
+    { "miss",         ShaderStage::MISS },
+    { "callable",     ShaderStage::CALLABLE },
+    { "task",         ShaderStage::TASK },
+    { "mesh",         ShaderStage::MESH },
+};
+
+std::optional<ShaderStage> find_stage(std::span<const StageName> table, std::string_view name) {
+    for (const auto& entry : table) {
+        if (entry.name == name)
+            return entry.stage;
+    }
+    return std::nullopt;
+}
+
+bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+}
+
+bool is_identifier(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+// Tiny cursor over one directive line.
+struct Cursor {
+    std::string_view text;
+
+    void skip_space() {
+        while (!text.empty() && is_space(text.front()))
+            text.remove_prefix(1);
+    }
+    std::string_view identifier() {
+        skip_space();
+        size_t n = 0;
+        while (n < text.size() && is_identifier(text[n]))
+            ++n;
+        auto word = text.substr(0, n);
+        text.remove_prefix(n);
+        return word;
+    }
+    bool consume(char c) {
+        skip_space();
+        if (text.empty() || text.front() != c)
+            return false;
+        text.remove_prefix(1);
+        return true;
+    }
+};
+
+void parse_directive(std::string_view text, uint32_t line, ShaderScanInfo& info) {
+    Cursor cursor{ text };
+    const auto directive = cursor.identifier();
+
+    if (directive == "version") {
+        if (info.version != 0)
+            return;
+        cursor.skip_space();
+        uint32_t version = 0;
+        const auto* end = cursor.text.data() + cursor.text.size();
+        const auto [ptr, ec] = std::from_chars(cursor.text.data(), end, version);
+        if (ec != std::errc())
+            return;
+        cursor.text.remove_prefix(static_cast<size_t>(ptr - cursor.text.data()));
+        info.version = version;
+        info.profile = std::string(cursor.identifier());
+    } else if (directive == "extension") {
+        const auto name = cursor.identifier();
+        if (name.empty() || !cursor.consume(':'))
+            return;
+        info.extensions.push_back({ std::string(name), std::string(cursor.identifier()) });
+    } else if (directive == "include") {
+        cursor.skip_space();
+        if (cursor.text.empty())
+            return;
+        const char open = cursor.text.front();
+        const char close = open == '"' ? '"' : open == '<' ? '>' : '\0';
+        if (!close)
+            return;
+        const size_t end = cursor.text.find(close, 1);
+        if (end == std::string_view::npos || end == 1)
+            return;
+        info.includes.push_back({ std::string(cursor.text.substr(1, end - 1)), open == '<', line });
+    } else if (directive == "pragma") {
+        if (cursor.identifier() != "shader_stage" || !cursor.consume('('))
+            return;
+        if (auto stage = find_stage(StagePragmas, cursor.identifier()); stage && cursor.consume(')'))
+            info.stage = stage;
+    }
+}
+
+void add_extensions(std::vector<ShaderExtension>& out, std::unordered_set<std::string>& seen, const std::vector<ShaderExtension>& extensions) {
+    for (const auto& extension : extensions) {
+        if (seen.insert(extension.name).second)
+            out.push_back(extension);
+    }
+}
+
+void append_escaped(std::string& out, std::string_view path) {
+    for (const char c : path) {
+        if (c == ' ' || c == '#')
+            out += '\\';
+        else if (c == '$')
+            out += '$';
+        out += c;
+    }
+}
+}
+
+ShaderScanInfo scan_shader(std::string_view source) {
+    ShaderScanInfo info;
+
+    const size_t n = source.size();
+    size_t i = 0;
+    uint32_t line = 1;
+    bool lineStart = true; // only whitespace / comments so far on this line
+
+    while (i < n) {
+        const char c = source[i];
+        if (c == '\n') {
+            ++line;
+            lineStart = true;
+            ++i;
+        } else if (is_space(c)) {
+            ++i;
+        } else if (c == '/' && i + 1 < n && source[i + 1] == '/') {
+            i = std::min(source.find('\n', i), n);
+        } else if (c == '/' && i + 1 < n && source[i + 1] == '*') {
+            const size_t close = source.find("*/", i + 2);
+            const size_t end = close == std::string_view::npos ? n : close + 2;
+            line += static_cast<uint32_t>(std::count(source.begin() + i, source.begin() + end, '\n'));
+            i = end;
+        } else if (c == '#' && lineStart) {
+            const size_t end = std::min(source.find('\n', i), n);
+            auto text = source.substr(i + 1, end - i - 1);
+
+            // A comment ends the directive. Block comments are left to the loop, they may run over several lines.
+            const size_t comment = std::min(text.find("//"), text.find("/*"));
+            parse_directive(text.substr(0, comment), line, info);
+            i = comment == std::string_view::npos ? end : i + 1 + comment;
+            lineStart = false;
+        } else {
+            // Plain code, nothing of interest before the next line or comment.
+            lineStart = false;
+            ++i;
+            while (i < n && source[i] != '\n' && source[i] != '/')
+                ++i;
+        }
+    }
+
+    return info;
+}
+
+std::optional<ShaderStage> stage_from_extension(const fs::path& path) {
+    auto ext = path.extension();
+    if (ext == ".glsl")
+        ext = path.stem().extension();
+    return find_stage(StageExtensions, ext.string());
+}
+
+struct DependencyScanner::Impl {
+    std::vector<fs::path> includeDirectories;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const ShaderScanInfo>> headers; // canonical path -> scan, null if unreadable
+    std::unordered_map<std::string, std::optional<std::string>> resolved;            // directory + include -> canonical path
+
+    std::optional<std::string> resolve(const ShaderIncludeDirective& include, const std::string& includer);
+    std::shared_ptr<const ShaderScanInfo> header(const std::string& path);
+};
+
+std::optional<std::string> DependencyScanner::Impl::resolve(const ShaderIncludeDirective& include, const std::string& includer) {
+    const auto dir = include.system ? std::string() : fs::path(includer).parent_path().string();
+    std::string key = dir;
+    key += '\0';
+    key += include.name;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto it = resolved.find(key); it != resolved.end())
+            return it->second;
+    }
+
+    // Same order as FileIncluder.
+    std::optional<std::string> result;
+    std::error_code ec;
+    if (!include.system && fs::is_regular_file(fs::path(dir) / include.name, ec))
+        result = canonical_shader_path(fs::path(dir) / include.name);
+    for (size_t d = 0; !result && d < includeDirectories.size(); ++d) {
+        const auto candidate = includeDirectories[d] / include.name;
+        if (fs::is_regular_file(candidate, ec))
+            result = canonical_shader_path(candidate);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    resolved.emplace(std::move(key), result);
+    return result;
+}
+
+std::shared_ptr<const ShaderScanInfo> DependencyScanner::Impl::header(const std::string& path) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (auto it = headers.find(path); it != headers.end())
+            return it->second;
+    }
+
+    // Scanned outside the lock. Two threads may both scan a header the first time, they get the same answer.
+    // Read rather than mapped, headers get rewritten while we scan and a mapping that shrinks raises SIGBUS.
+    std::shared_ptr<const ShaderScanInfo> info;
+    try {
+        info = std::make_shared<const ShaderScanInfo>(scan_shader(load_shader_file(path)));
+    } catch (const std::exception&) {}
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return headers.emplace(path, std::move(info)).first->second;
+}
+
+DependencyScanner::DependencyScanner(std::vector<fs::path> includeDirectories) : impl(std::make_unique<Impl>()) {
+    impl->includeDirectories = std::move(includeDirectories);
+}
+
+DependencyScanner::~DependencyScanner() = default;
+
+ShaderDependencies DependencyScanner::scan(const fs::path& shader) const {
+    ShaderDependencies deps;
+    deps.info = scan_shader(load_shader_file(shader.string()));
+    deps.path = canonical_shader_path(shader);
+    if (!deps.info.stage)
+        deps.info.stage = stage_from_extension(shader);
+
+    std::unordered_set<std::string> seen{ deps.path };
+    std::unordered_set<std::string> extensionNames;
+    add_extensions(deps.extensions, extensionNames, deps.info.extensions);
+
+    // Depth first in include order, the order the preprocessor reaches the headers in.
+    const auto visit = [&](const auto& self, const std::string& file, const ShaderScanInfo& info) -> void {
+        for (const auto& include : info.includes) {
+            const auto path = impl->resolve(include, file);
+            const auto scanned = path ? impl->header(*path) : nullptr;
+            if (!scanned) {
+                if (std::find(deps.missing.begin(), deps.missing.end(), include.name) == deps.missing.end())
+                    deps.missing.push_back(include.name);
+                continue;
+            }
+            if (!seen.insert(*path).second)
+                continue;
+
+            deps.includes.push_back(*path);
+            add_extensions(deps.extensions, extensionNames, scanned->extensions);
+            self(self, *path, *scanned);
+        }
+    };
+    visit(visit, deps.path, deps.info);
+
+    return deps;
+}
+
+std::vector<ShaderDependencies> DependencyScanner::scan_all(std::span<const fs::path> shaders, ThreadPool& pool) const {
+    std::vector<ShaderDependencies> results(shaders.size());
+    pool.parallel_for(shaders.size(), [&](size_t i) {
+        try {
+            results[i] = scan(shaders[i]);
+        } catch (const std::exception& e) {
+            // Still names the shader, its depfile then at least depends on the file that failed.
+            results[i] = {};
+            results[i].path = canonical_shader_path(shaders[i]);
+            results[i].error = shaders[i].string() + ": " + e.what();
+        }
+    });
+    return results;
+}
+
+std::vector<ShaderDependencies> DependencyScanner::scan_all(std::span<const fs::path> shaders) const {
+    return scan_all(shaders, default_thread_pool());
+}
+
+void DependencyScanner::clear() {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->headers.clear();
+    impl->resolved.clear();
+}
+
+std::string make_depfile(std::string_view target, const ShaderDependencies& deps) {
+    std::string out;
+    append_escaped(out, target);
+    out += ':';
+    out += ' ';
+    append_escaped(out, deps.path);
+    for (const auto& include : deps.includes) {
+        out += " \\\n  ";
+        append_escaped(out, include);
+    }
+    out += '\n';
+    return out;
+}
+
+bool write_depfile(const fs::path& depfile, std::string_view target, const ShaderDependencies& deps) {
+    std::ofstream out(depfile, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+    out << make_depfile(target, deps);
+    return out.good();
+}
+}
@@ -0,0 +1,26 @@
+/*
+* File: shader_temp_file
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_TEMP_FILE_HPP
+#define SHADER_PIPE_SHADER_TEMP_FILE_HPP
+
+#include <string>
+
+namespace shaderpipe {
+
+// Appended to a destination path to get the temp file it is written through before the rename, ".tmp.<token>.<n>".
+// Unique per process (with overwhelming probability) and per call, so concurrent writers never share a temp file.
+std::string temp_file_suffix();
+
+}
+
+#endif //SHADER_PIPE_SHADER_TEMP_FILE_HPP
@@ -0,0 +1,204 @@
+/*
+* File: shader_thread_pool
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace shaderpipe {
+
+using Task = std::function<void()>;
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+struct ThreadPool::Impl {
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued{0};
+    std::atomic<uint32_t> nextQueue{0};
+    bool stop = false;
+
+    void push(Task task);
+    bool pop(uint32_t index, Task& out);
+    bool run_one();
+    void worker_loop(uint32_t index);
+};
+
+// Which pool (and which of its queues) the current thread belongs to, if any.
+static thread_local const void* tlsPool = nullptr;
+static thread_local uint32_t tlsIndex = 0;
+
+void ThreadPool::Impl::push(Task task) {
+    const uint32_t count = static_cast<uint32_t>(queues.size());
+    const uint32_t index = (tlsPool == this) ? tlsIndex : nextQueue.fetch_add(1, std::memory_order_relaxed) % count;
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Bumping the counter under the sleep mutex is what keeps a worker from missing the wake up.
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::Impl::pop(uint32_t index, Task& out) {
+    const uint32_t count = static_cast<uint32_t>(queues.size());
+
+    // Own queue first (newest work, hot in cache)...
+    if (index < count) {
+        auto& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            out = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+
+    // ...then steal the oldest work from everyone else.
+    const uint32_t start = index < count ? index + 1 : 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& victim = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            out = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::Impl::run_one() {
+    Task task;
+    const uint32_t index = (tlsPool == this) ? tlsIndex : static_cast<uint32_t>(queues.size());
+    if (!pop(index, task))
+        return false;
+    task();
+    return true;
+}
+
+void ThreadPool::Impl::worker_loop(uint32_t index) {
+    tlsPool = this;
+    tlsIndex = index;
+
+    for (;;) {
+        Task task;
+        if (pop(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stop || queued.load(std::memory_order_acquire) > 0; });
+        if (stop && queued.load(std::memory_order_acquire) == 0)
+            return;
+    }
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount) : impl(std::make_unique<Impl>()) {
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    impl->queues.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        impl->queues.push_back(std::make_unique<WorkQueue>());
+
+    impl->workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        impl->workers.emplace_back([this, i] { impl->worker_loop(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(impl->sleepMutex);
+        impl->stop = true;
+    }
+    impl->wake.notify_all();
+    for (auto& worker : impl->workers)
+        worker.join();
+}
+
+uint32_t ThreadPool::thread_count() const {
+    return static_cast<uint32_t>(impl->workers.size());
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    impl->push(std::move(task));
+}
+
+void ThreadPool::parallel_for(size_t count, const std::function<void(size_t)>& body) {
+    if (count == 0)
+        return;
+
+    struct Group {
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    } group;
+    group.remaining.store(count);
+
+    // One task per index. Shader compiles are heavy enough that the per task overhead does not matter,
+    // and fine grained tasks are what lets stealing even out wildly different job sizes.
+    for (size_t i = 0; i < count; ++i) {
+        impl->push([&group, &body, i] {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(group.mutex);
+                if (!group.error)
+                    group.error = std::current_exception();
+            }
+            // Decrement under the lock, otherwise the waiter could return and destroy group under our feet.
+            std::lock_guard<std::mutex> lock(group.mutex);
+            if (group.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                group.done.notify_all();
+        });
+    }
+
+    // Help instead of just blocking. This is also what makes nested parallel_for calls from a worker safe.
+    while (group.remaining.load(std::memory_order_acquire) > 0 && impl->run_one()) {}
+
+    {
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.done.wait(lock, [&group] { return group.remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    if (group.error)
+        std::rethrow_exception(group.error);
+}
+
+ThreadPool& default_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+}
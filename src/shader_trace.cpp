@@ -0,0 +1,212 @@
+/*
+* File: shader_trace
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_trace.hpp"
+#include "shader_trace_internal.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    #include <malloc.h>
+    #define SHADERPIPE_HAS_MALLINFO2 1
+#endif
+
+namespace shaderpipe {
+
+std::atomic<bool> TracingEnabled{false};
+
+static std::mutex sinkMutex;
+static std::shared_ptr<TraceSink> installedSink;
+
+static thread_local CompileTrace* currentTrace = nullptr;
+
+static constexpr const char* PhaseNames[] = {
+    "preprocess",
+    "parse",
+    "link",
+    "spirv_gen",
+    "optimize",
+    "reflect",
+    "cross_compile",
+    "cache_lookup",
+    "cache_store",
+};
+static_assert(std::size(PhaseNames) == static_cast<size_t>(TracePhase::COUNT));
+
+static constexpr const char* CacheResultNames[] = { "not_cached", "hit", "miss" };
+
+const char* trace_phase_name(TracePhase phase) {
+    const auto i = static_cast<size_t>(phase);
+    return i < std::size(PhaseNames) ? PhaseNames[i] : "unknown";
+}
+
+uint64_t trace_now_ns() {
+    using Clock = std::chrono::steady_clock;
+    static const Clock::time_point epoch = Clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+}
+
+static uint32_t trace_thread_id() {
+    static std::atomic<uint32_t> next{1};
+    thread_local const uint32_t id = next.fetch_add(1);
+    return id;
+}
+
+// Takes every arena lock in glibc, so this runs once per top level call and never per phase.
+static size_t heap_in_use() {
+#ifdef SHADERPIPE_HAS_MALLINFO2
+    const auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+void set_trace_sink(std::shared_ptr<TraceSink> sink) {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    TracingEnabled.store(sink != nullptr, std::memory_order_relaxed);
+    installedSink = std::move(sink);
+}
+
+std::shared_ptr<TraceSink> get_trace_sink() {
+    std::lock_guard<std::mutex> lock(sinkMutex);
+    return installedSink;
+}
+
+CompileTrace* CompileTrace::current() {
+    return currentTrace;
+}
+
+void CompileTrace::begin(const char* operation, const std::filesystem::path& name, std::optional<ShaderStage> stage) {
+    if (currentTrace) {
+        owner = currentTrace;
+        if (!owner->stats.stage)
+            owner->stats.stage = stage;
+        return;
+    }
+
+    // Held for the whole call, swapping sinks meanwhile can not pull this one out from under us.
+    sink = get_trace_sink();
+    if (!sink)
+        return;
+
+    owner = this;
+    currentTrace = this;
+    stats.operation = operation;
+    stats.name = name.string();
+    stats.stage = stage;
+    stats.threadId = trace_thread_id();
+    stats.beginNs = trace_now_ns();
+}
+
+void CompileTrace::end() {
+    stats.totalNs = trace_now_ns() - stats.beginNs;
+    stats.processHeapBytes = heap_in_use();
+    currentTrace = nullptr;
+
+    // Runs from a destructor, a sink that throws must not take the process down with it.
+    try {
+        sink->on_compile(stats);
+    } catch (...) {}
+}
+
+void CompileTrace::record_cache(CacheResult result) {
+    // A memory cache miss followed by a disk cache hit is still a hit.
+    if (result == CacheResult::HIT || stats.cache == CacheResult::NOT_CACHED)
+        stats.cache = result;
+}
+
+void CompileTrace::record_phase(TracePhase phase, uint64_t beginNs, uint64_t endNs) {
+    stats.phaseNs[static_cast<size_t>(phase)] += endNs - beginNs;
+
+    // Called from TraceScope's destructor, same as end().
+    try {
+        sink->on_phase({ phase, &stats, beginNs, endNs - beginNs });
+    } catch (...) {}
+}
+
+static std::string json_escape(std::string_view str) {
+    std::string out;
+    out.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+static std::string compile_label(const CompileStats& stats) {
+    return stats.name.empty() ? std::string(stats.operation) : std::string(stats.operation) + " " + stats.name;
+}
+
+// Complete ("X") events, timestamps in microseconds.
+static std::string complete_event(std::string_view name, const char* category, uint64_t beginNs, uint64_t durationNs,
+                                  uint32_t threadId, const std::string& args) {
+    char times[96];
+    std::snprintf(times, sizeof(times), "\"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %u",
+                  static_cast<double>(beginNs) / 1000.0, static_cast<double>(durationNs) / 1000.0, threadId);
+    return "{\"name\": \"" + json_escape(name) + "\", \"cat\": \"" + category + "\", \"ph\": \"X\", " + times +
+           ", \"args\": {" + args + "}}";
+}
+
+void ChromeTraceSink::on_phase(const TraceEvent& event) {
+    auto line = complete_event(trace_phase_name(event.phase), "phase", event.beginNs, event.durationNs,
+                               event.compile->threadId, "\"compile\": \"" + json_escape(compile_label(*event.compile)) + "\"");
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(std::move(line));
+}
+
+void ChromeTraceSink::on_compile(const CompileStats& stats) {
+    std::string args = "\"success\": " + std::string(stats.success ? "true" : "false") +
+                       ", \"spirv_words\": " + std::to_string(stats.spirvWords) +
+                       ", \"process_heap_bytes\": " + std::to_string(stats.processHeapBytes) +
+                       ", \"cache\": \"" + CacheResultNames[static_cast<size_t>(stats.cache)] + "\"";
+    if (stats.stage)
+        args += ", \"stage\": " + std::to_string(static_cast<uint32_t>(*stats.stage));
+
+    auto line = complete_event(compile_label(stats), "compile", stats.beginNs, stats.totalNs, stats.threadId, args);
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(std::move(line));
+}
+
+void ChromeTraceSink::write(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for (size_t i = 0; i < events.size(); ++i)
+        out << events[i] << (i + 1 < events.size() ? ",\n" : "\n");
+    out << "]}\n";
+}
+
+bool ChromeTraceSink::save(const std::filesystem::path& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+    write(out);
+    return out.good();
+}
+
+void ChromeTraceSink::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+}
+}
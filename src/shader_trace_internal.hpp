@@ -0,0 +1,96 @@
+/*
+* File: shader_trace_internal
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_SHADER_TRACE_INTERNAL_HPP
+#define SHADER_PIPE_SHADER_TRACE_INTERNAL_HPP
+
+#include "shader_trace.hpp"
+
+#include <atomic>
+
+namespace shaderpipe {
+
+extern std::atomic<bool> TracingEnabled;
+
+// Nanoseconds since the first call, the shared time base of every trace event.
+uint64_t trace_now_ns();
+
+// Wraps one public entry point. Reports a CompileStats to the sink when it goes out of scope, marked failed unless
+// succeeded() was reached. A trace opened while another one is running on the same thread (glsl_to_spirv calling
+// preprocess, the memory cache calling the compiler) adds its phases to the outer one instead.
+class CompileTrace {
+public:
+    CompileTrace(const char* operation, const std::filesystem::path& name = {}, std::optional<ShaderStage> stage = {}) {
+        if (TracingEnabled.load(std::memory_order_relaxed))
+            begin(operation, name, stage);
+    }
+    ~CompileTrace() {
+        if (sink)
+            end();
+    }
+
+    CompileTrace(const CompileTrace&) = delete;
+    CompileTrace& operator=(const CompileTrace&) = delete;
+
+    void set_cache(CacheResult result) {
+        if (owner)
+            owner->record_cache(result);
+    }
+    void set_spirv_words(size_t words) {
+        if (owner)
+            owner->stats.spirvWords = words;
+    }
+    void succeeded() {
+        if (sink)
+            stats.success = true;
+    }
+
+    // The outermost trace running on this thread, nullptr when not tracing.
+    static CompileTrace* current();
+
+private:
+    friend class TraceScope;
+
+    void begin(const char* operation, const std::filesystem::path& name, std::optional<ShaderStage> stage);
+    void end();
+    void record_cache(CacheResult result);
+    void record_phase(TracePhase phase, uint64_t beginNs, uint64_t endNs);
+
+    CompileTrace* owner = nullptr;    // this, the outer trace, or nullptr when tracing is off
+    std::shared_ptr<TraceSink> sink;  // only set on the outermost trace
+    CompileStats stats;
+};
+
+// Times one phase of the current trace, does nothing when there is none.
+class TraceScope {
+public:
+    explicit TraceScope(TracePhase phase)
+        : trace(TracingEnabled.load(std::memory_order_relaxed) ? CompileTrace::current() : nullptr), phase(phase) {
+        if (trace)
+            beginNs = trace_now_ns();
+    }
+    ~TraceScope() {
+        if (trace)
+            trace->record_phase(phase, beginNs, trace_now_ns());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    CompileTrace* trace;
+    TracePhase phase;
+    uint64_t beginNs = 0;
+};
+}
+
+#endif //SHADER_PIPE_SHADER_TRACE_INTERNAL_HPP
@@ -0,0 +1,180 @@
+/*
+* File: shader_variants
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_variants.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace shaderpipe {
+
+using DefinesFor = std::function<void(uint32_t permutation, std::vector<ShaderDefine>& defines)>;
+
+static ShaderHash hash_spirv(const std::vector<uint32_t>& spirv) {
+    Hasher h;
+    h.update(spirv.data(), spirv.size() * sizeof(uint32_t));
+    return h.finish();
+}
+
+static VariantSet compile_permutations(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                                       uint32_t count, const DefinesFor& definesFor, const CompileOptions& options, ThreadPool& pool) {
+    VariantSet set;
+    set.permutationModules.assign(count, VariantSet::InvalidModule);
+
+    std::mutex errorMutex;
+    auto fail = [&](uint32_t permutation, const char* what) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        set.errors.emplace_back(permutation, what);
+    };
+
+    auto options_for = [&](uint32_t permutation) {
+        CompileOptions opt = options;
+        definesFor(permutation, opt.defines);
+        return opt;
+    };
+
+    // Pass 1: preprocess everything. Only a hash of the text is kept, not the text itself.
+    std::vector<ShaderHash> textHashes(count);
+    std::vector<uint8_t> preprocessed(count, 0);
+    pool.parallel_for(count, [&](size_t i) {
+        const auto permutation = static_cast<uint32_t>(i);
+        try {
+            Hasher h;
+            h.update(compiler.preprocess(source, stage, targetVulkanVersion, options_for(permutation)));
+            textHashes[i] = h.finish();
+            preprocessed[i] = 1;
+        } catch (const std::exception& e) {
+            fail(permutation, e.what());
+        }
+    });
+
+    // Permutations that expand to the same text compile to the same module, compile one representative each.
+    std::unordered_map<ShaderHash, uint32_t> groupOf;
+    std::vector<uint32_t> representatives;
+    std::vector<uint32_t> permutationGroup(count, VariantSet::InvalidModule);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!preprocessed[i])
+            continue;
+        auto [it, inserted] = groupOf.try_emplace(textHashes[i], static_cast<uint32_t>(representatives.size()));
+        if (inserted)
+            representatives.push_back(i);
+        permutationGroup[i] = it->second;
+    }
+    textHashes = {};
+    groupOf = {};
+
+    // Pass 2: compile the distinct ones.
+    std::vector<BatchResult> results(representatives.size());
+    pool.parallel_for(representatives.size(), [&](size_t g) {
+        auto& result = results[g];
+        try {
+            result.shader = compiler.glsl_to_spirv_with_reflection(source, stage, targetVulkanVersion, options_for(representatives[g]));
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+    });
+
+    // Different text can still produce the same SPIR-V (e.g. a define that only renames something), fold those as well.
+    std::unordered_map<ShaderHash, uint32_t> moduleOf;
+    std::vector<uint32_t> groupModule(results.size(), VariantSet::InvalidModule);
+    for (size_t g = 0; g < results.size(); ++g) {
+        auto& result = results[g];
+        if (!result.success)
+            continue;
+        const auto hash = hash_spirv(result.shader.spirv);
+        auto [it, inserted] = moduleOf.try_emplace(hash, static_cast<uint32_t>(set.modules.size()));
+        if (inserted) {
+            set.modules.push_back(std::move(result.shader));
+            set.moduleHashes.push_back(hash);
+        }
+        groupModule[g] = it->second;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto group = permutationGroup[i];
+        if (group == VariantSet::InvalidModule)
+            continue;
+        set.permutationModules[i] = groupModule[group];
+        if (!results[group].success)
+            set.errors.emplace_back(i, results[group].error);
+    }
+
+    std::sort(set.errors.begin(), set.errors.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return set;
+}
+
+uint32_t VariantSet::permutation_index(std::span<const uint32_t> choices) const {
+    if (choices.size() != axisSizes.size())
+        throw std::runtime_error("Expected one choice per define axis.");
+
+    uint32_t index = 0;
+    uint32_t stride = 1;
+    for (size_t i = 0; i < choices.size(); ++i) {
+        if (choices[i] >= axisSizes[i])
+            throw std::runtime_error("Choice out of range for define axis " + std::to_string(i) + ".");
+        index += choices[i] * stride;
+        stride *= axisSizes[i];
+    }
+    return index;
+}
+
+const CompiledShader* VariantSet::find(uint32_t permutation) const {
+    if (permutation >= permutationModules.size() || permutationModules[permutation] == InvalidModule)
+        return nullptr;
+    return &modules[permutationModules[permutation]];
+}
+
+VariantSet compile_variants(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                            std::span<const DefineAxis> axes, const CompileOptions& options, ThreadPool& pool) {
+    std::vector<uint32_t> sizes;
+    sizes.reserve(axes.size());
+    uint64_t count = 1;
+    for (const auto& axis : axes) {
+        if (axis.values.empty())
+            throw std::runtime_error("Define axis '" + axis.name + "' has no values.");
+        count *= axis.values.size();
+        if (count >= VariantSet::InvalidModule)
+            throw std::runtime_error("Too many shader permutations.");
+        sizes.push_back(static_cast<uint32_t>(axis.values.size()));
+    }
+
+    auto definesFor = [&](uint32_t permutation, std::vector<ShaderDefine>& defines) {
+        for (size_t i = 0; i < axes.size(); ++i) {
+            const auto& value = axes[i].values[permutation % sizes[i]];
+            permutation /= sizes[i];
+            if (value)
+                defines.push_back({ axes[i].name, *value });
+        }
+    };
+
+    auto set = compile_permutations(compiler, source, stage, targetVulkanVersion, static_cast<uint32_t>(count), definesFor, options, pool);
+    set.axisSizes = std::move(sizes);
+    return set;
+}
+
+VariantSet compile_variants(const Compiler& compiler, std::string_view source, ShaderStage stage, VKVersion targetVulkanVersion,
+                            std::span<const std::vector<ShaderDefine>> permutations, const CompileOptions& options, ThreadPool& pool) {
+    if (permutations.size() >= VariantSet::InvalidModule)
+        throw std::runtime_error("Too many shader permutations.");
+
+    auto definesFor = [&](uint32_t permutation, std::vector<ShaderDefine>& defines) {
+        const auto& extra = permutations[permutation];
+        defines.insert(defines.end(), extra.begin(), extra.end());
+    };
+
+    return compile_permutations(compiler, source, stage, targetVulkanVersion, static_cast<uint32_t>(permutations.size()), definesFor, options, pool);
+}
+}
@@ -0,0 +1,168 @@
+/*
+* File: shader_vertex_input
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_vertex_input.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace shaderpipe {
+
+namespace {
+struct FormatInfo {
+    uint32_t size;      // bytes per element, 0 => not a vertex format
+    uint32_t alignment; // component size, or the whole element for packed formats
+};
+
+constexpr bool in_range(VkFormat format, VkFormat first, VkFormat last) {
+    return format >= first && format <= last;
+}
+
+FormatInfo format_info(VkFormat f) {
+    // 8 bit components
+    if (in_range(f, VK_FORMAT_R8_UNORM, VK_FORMAT_R8_SRGB))                             return { 1, 1 };
+    if (in_range(f, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8_SRGB))                         return { 2, 1 };
+    if (in_range(f, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_B8G8R8_SRGB))                     return { 3, 1 };
+    if (in_range(f, VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_B8G8R8A8_SRGB))                 return { 4, 1 };
+
+    // Packed into one 32 bit word
+    if (in_range(f, VK_FORMAT_A8B8G8R8_UNORM_PACK32, VK_FORMAT_A2B10G10R10_SINT_PACK32)) return { 4, 4 };
+    if (f == VK_FORMAT_B10G11R11_UFLOAT_PACK32)                                         return { 4, 4 };
+
+    // 16 bit components
+    if (in_range(f, VK_FORMAT_R16_UNORM, VK_FORMAT_R16_SFLOAT))                         return { 2, 2 };
+    if (in_range(f, VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16_SFLOAT))                   return { 4, 2 };
+    if (in_range(f, VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16_SFLOAT))             return { 6, 2 };
+    if (in_range(f, VK_FORMAT_R16G16B16A16_UNORM, VK_FORMAT_R16G16B16A16_SFLOAT))       return { 8, 2 };
+
+    // 32 bit components
+    if (in_range(f, VK_FORMAT_R32_UINT, VK_FORMAT_R32_SFLOAT))                          return { 4, 4 };
+    if (in_range(f, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32_SFLOAT))                    return { 8, 4 };
+    if (in_range(f, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32_SFLOAT))              return { 12, 4 };
+    if (in_range(f, VK_FORMAT_R32G32B32A32_UINT, VK_FORMAT_R32G32B32A32_SFLOAT))        return { 16, 4 };
+
+    // 64 bit components
+    if (in_range(f, VK_FORMAT_R64_UINT, VK_FORMAT_R64_SFLOAT))                          return { 8, 8 };
+    if (in_range(f, VK_FORMAT_R64G64_UINT, VK_FORMAT_R64G64_SFLOAT))                    return { 16, 8 };
+    if (in_range(f, VK_FORMAT_R64G64B64_UINT, VK_FORMAT_R64G64B64_SFLOAT))              return { 24, 8 };
+    if (in_range(f, VK_FORMAT_R64G64B64A64_UINT, VK_FORMAT_R64G64B64A64_SFLOAT))        return { 32, 8 };
+
+    return { 0, 0 };
+}
+
+uint32_t align_to(uint32_t v, uint32_t alignment) {
+    return (v + alignment - 1) / alignment * alignment;
+}
+}
+
+VkFormat vertex_format(ScalarType type, uint32_t bitWidth, uint32_t components) {
+    static constexpr VkFormat Float16[] = { VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT };
+    static constexpr VkFormat Float32[] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+    static constexpr VkFormat Float64[] = { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+    static constexpr VkFormat Int8[]    = { VK_FORMAT_R8_SINT, VK_FORMAT_R8G8_SINT, VK_FORMAT_R8G8B8_SINT, VK_FORMAT_R8G8B8A8_SINT };
+    static constexpr VkFormat Int16[]   = { VK_FORMAT_R16_SINT, VK_FORMAT_R16G16_SINT, VK_FORMAT_R16G16B16_SINT, VK_FORMAT_R16G16B16A16_SINT };
+    static constexpr VkFormat Int32[]   = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+    static constexpr VkFormat Int64[]   = { VK_FORMAT_R64_SINT, VK_FORMAT_R64G64_SINT, VK_FORMAT_R64G64B64_SINT, VK_FORMAT_R64G64B64A64_SINT };
+    static constexpr VkFormat UInt8[]   = { VK_FORMAT_R8_UINT, VK_FORMAT_R8G8_UINT, VK_FORMAT_R8G8B8_UINT, VK_FORMAT_R8G8B8A8_UINT };
+    static constexpr VkFormat UInt16[]  = { VK_FORMAT_R16_UINT, VK_FORMAT_R16G16_UINT, VK_FORMAT_R16G16B16_UINT, VK_FORMAT_R16G16B16A16_UINT };
+    static constexpr VkFormat UInt32[]  = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+    static constexpr VkFormat UInt64[]  = { VK_FORMAT_R64_UINT, VK_FORMAT_R64G64_UINT, VK_FORMAT_R64G64B64_UINT, VK_FORMAT_R64G64B64A64_UINT };
+
+    if (components < 1 || components > 4)
+        return VK_FORMAT_UNDEFINED;
+
+    const VkFormat* table = nullptr;
+    switch (type) {
+        case ScalarType::FLOAT: table = bitWidth == 16 ? Float16 : bitWidth == 32 ? Float32 : bitWidth == 64 ? Float64 : nullptr; break;
+        case ScalarType::INT:   table = bitWidth == 8 ? Int8 : bitWidth == 16 ? Int16 : bitWidth == 32 ? Int32 : bitWidth == 64 ? Int64 : nullptr; break;
+        case ScalarType::UINT:  table = bitWidth == 8 ? UInt8 : bitWidth == 16 ? UInt16 : bitWidth == 32 ? UInt32 : bitWidth == 64 ? UInt64 : nullptr; break;
+        case ScalarType::BOOL:  break;
+    }
+    return table ? table[components - 1] : VK_FORMAT_UNDEFINED;
+}
+
+uint32_t vertex_format_size(VkFormat format) {
+    return format_info(format).size;
+}
+
+VkPipelineVertexInputStateCreateInfo VertexInputLayout::create_info() const {
+    VkPipelineVertexInputStateCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    info.vertexBindingDescriptionCount   = static_cast<uint32_t>(bindings.size());
+    info.pVertexBindingDescriptions      = bindings.data();
+    info.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributes.size());
+    info.pVertexAttributeDescriptions    = attributes.data();
+    return info;
+}
+
+VertexInputLayout generate_vertex_input(std::span<const InputAttributeInfo> inputs, const VertexInputOptions& options) {
+    struct Slot {
+        uint32_t location;
+        VkFormat format;
+        FormatInfo info;
+    };
+
+    std::vector<Slot> slots;
+    for (const auto& input : inputs) {
+        if (input.baseType == ScalarType::BOOL)
+            throw std::runtime_error("Vertex input '" + input.name + "' is a bool, booleans can not be read from a vertex buffer.");
+
+        VkFormat natural = vertex_format(input.baseType, input.bitWidth, input.vecSize);
+        if (natural == VK_FORMAT_UNDEFINED)
+            throw std::runtime_error("Vertex input '" + input.name + "' has no matching vertex format.");
+        if (options.halfFloats && input.baseType == ScalarType::FLOAT && input.bitWidth == 32)
+            natural = vertex_format(ScalarType::FLOAT, 16, input.vecSize == 3 ? 4 : input.vecSize);
+
+        // dvec3 / dvec4 are the only types that need two locations per column.
+        const uint32_t locationsPerColumn = input.bitWidth == 64 && input.vecSize > 2 ? 2 : 1;
+        const uint32_t columns = std::max(input.columns, 1u) * std::max(input.arraySize, 1u);
+
+        uint32_t location = input.location;
+        for (uint32_t c = 0; c < columns; ++c, location += locationsPerColumn) {
+            auto it = std::find_if(options.overrides.begin(), options.overrides.end(),
+                                   [&](const VertexFormatOverride& o) { return o.location == location; });
+            const VkFormat format = it != options.overrides.end() ? it->format : natural;
+            const FormatInfo info = format_info(format);
+            if (info.size == 0)
+                throw std::runtime_error("Format " + std::to_string(format) + " for location " + std::to_string(location) + " is not a vertex format.");
+            slots.push_back({ location, format, info });
+        }
+    }
+    std::sort(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) { return a.location < b.location; });
+
+    VertexInputLayout layout;
+    if (slots.empty())
+        return layout;
+
+    layout.attributes.reserve(slots.size());
+    if (options.layout == VertexLayout::INTERLEAVED) {
+        uint32_t offset = 0;
+        uint32_t strideAlignment = 1;
+        for (const auto& slot : slots) {
+            offset = align_to(offset, slot.info.alignment);
+            layout.attributes.push_back({ slot.location, options.firstBinding, slot.format, offset });
+            offset += slot.info.size;
+            strideAlignment = std::max(strideAlignment, slot.info.alignment);
+        }
+        layout.bindings.push_back({ options.firstBinding, align_to(offset, strideAlignment), options.inputRate });
+    } else {
+        layout.bindings.reserve(slots.size());
+        uint32_t binding = options.firstBinding;
+        for (const auto& slot : slots) {
+            layout.attributes.push_back({ slot.location, binding, slot.format, 0 });
+            layout.bindings.push_back({ binding, slot.info.size, options.inputRate });
+            ++binding;
+        }
+    }
+    return layout;
+}
+}
@@ -0,0 +1,316 @@
+/*
+* File: shader_watcher
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "shader_watcher.hpp"
+#include "shader_thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef __linux__
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+namespace shaderpipe {
+
+namespace fs = std::filesystem;
+
+// Editors tend to save in several steps (truncate, write, rename), wait for things to settle before rebuilding.
+static constexpr int DebounceMs = 50;
+#ifndef __linux__
+static constexpr int PollIntervalMs = 250;
+#endif
+
+struct ShaderWatcher::Impl {
+    Impl(const Compiler& compiler, ShaderRebuiltCallback callback)
+        : compiler(compiler), callback(std::move(callback)) {}
+
+    const Compiler& compiler;
+    ShaderRebuiltCallback callback;
+    DependencyGraph graph;
+
+    std::mutex mutex;
+    std::unordered_map<std::string, WatchedShader> shaders;
+
+    // Held for a whole rebuild, compile through callbacks, whichever thread runs it. Recursive so a callback
+    // may add() or notify_changed() itself.
+    std::recursive_mutex rebuildMutex;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+
+#ifdef __linux__
+    int inotifyFd = -1;
+    int wakePipe[2] = { -1, -1 };
+    std::unordered_map<int, fs::path> watchDirs; // wd -> directory
+    std::unordered_set<std::string> watchedDirSet;
+#else
+    std::mutex sleepMutex;
+    std::condition_variable sleep;
+    std::unordered_map<std::string, fs::file_time_type> mtimes;
+#endif
+
+    void rebuild(const std::vector<std::string>& affected);
+    void sync_watches();
+    void run();
+};
+
+void ShaderWatcher::Impl::rebuild(const std::vector<std::string>& affected) {
+    std::lock_guard<std::recursive_mutex> rebuildLock(rebuildMutex);
+
+    std::vector<WatchedShader> todo;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& key : affected) {
+            if (auto it = shaders.find(key); it != shaders.end())
+                todo.push_back(it->second);
+        }
+    }
+    if (todo.empty())
+        return;
+
+    std::vector<BatchResult> results(todo.size());
+    default_thread_pool().parallel_for(todo.size(), [&](size_t i) {
+        const auto& shader = todo[i];
+        auto& result = results[i];
+        try {
+            // Read rather than mapped, the editor may still be truncating the file and a shrinking mapping raises SIGBUS.
+            const auto source = load_shader_file(shader.path.string());
+
+            // Refresh the includes first, a header may have started including another one.
+            std::vector<std::string> includes;
+            compiler.preprocess(source, shader.stage, shader.targetVulkanVersion, shader.options, &includes);
+            graph.set_dependencies(canonical_shader_path(shader.path), includes);
+
+            result.shader = compiler.glsl_to_spirv_with_reflection(source, shader.stage, shader.targetVulkanVersion, shader.options);
+            result.success = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+        }
+    });
+
+    sync_watches();
+
+    // Still under rebuildMutex, so callbacks never overlap and callers do not need their own locking.
+    if (callback) {
+        for (size_t i = 0; i < todo.size(); ++i)
+            callback(todo[i], results[i]);
+    }
+}
+
+#ifdef __linux__
+
+void ShaderWatcher::Impl::sync_watches() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (inotifyFd < 0)
+        return;
+
+    // Directories rather than files: most editors save by writing a new file and renaming it over the old one.
+    for (const auto& file : graph.files()) {
+        auto dir = fs::path(file).parent_path();
+        if (watchedDirSet.count(dir.string()))
+            continue;
+        int wd = inotify_add_watch(inotifyFd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE);
+        if (wd < 0)
+            continue;
+        watchDirs[wd] = dir;
+        watchedDirSet.insert(dir.string());
+    }
+}
+
+void ShaderWatcher::Impl::run() {
+    std::set<std::string> pending;
+
+    while (running.load()) {
+        pollfd fds[2] = {
+            { inotifyFd, POLLIN, 0 },
+            { wakePipe[0], POLLIN, 0 },
+        };
+        const int r = poll(fds, 2, pending.empty() ? -1 : DebounceMs);
+        if (r < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (fds[1].revents & POLLIN)
+            break;
+
+        if (r == 0) {
+            // Quiet for a moment, rebuild everything that piled up.
+            std::set<std::string> affected;
+            for (const auto& file : pending) {
+                for (auto& shader : graph.affected_shaders(file))
+                    affected.insert(std::move(shader));
+            }
+            pending.clear();
+            rebuild({ affected.begin(), affected.end() });
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            alignas(inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(p);
+                    if (event->len > 0) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (auto it = watchDirs.find(event->wd); it != watchDirs.end())
+                            pending.insert(canonical_shader_path(it->second / event->name));
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+    }
+}
+
+#else
+
+void ShaderWatcher::Impl::sync_watches() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& file : graph.files()) {
+        if (mtimes.count(file))
+            continue;
+        std::error_code ec;
+        mtimes[file] = fs::last_write_time(file, ec);
+    }
+}
+
+void ShaderWatcher::Impl::run() {
+    while (running.load()) {
+        {
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleep.wait_for(lock, std::chrono::milliseconds(PollIntervalMs), [this] { return !running.load(); });
+        }
+        if (!running.load())
+            break;
+
+        std::vector<std::string> changed;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& [file, time] : mtimes) {
+                std::error_code ec;
+                auto now = fs::last_write_time(file, ec);
+                if (!ec && now != time) {
+                    time = now;
+                    changed.push_back(file);
+                }
+            }
+        }
+        if (changed.empty())
+            continue;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(DebounceMs));
+
+        std::set<std::string> affected;
+        for (const auto& file : changed) {
+            for (auto& shader : graph.affected_shaders(file))
+                affected.insert(std::move(shader));
+        }
+        rebuild({ affected.begin(), affected.end() });
+    }
+}
+
+#endif
+
+ShaderWatcher::ShaderWatcher(const Compiler& compiler, ShaderRebuiltCallback callback)
+    : impl(std::make_unique<Impl>(compiler, std::move(callback))) {
+#ifdef __linux__
+    impl->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (pipe2(impl->wakePipe, O_CLOEXEC | O_NONBLOCK) != 0)
+        impl->wakePipe[0] = impl->wakePipe[1] = -1;
+#endif
+}
+
+ShaderWatcher::~ShaderWatcher() {
+    stop();
+#ifdef __linux__
+    if (impl->inotifyFd >= 0)
+        close(impl->inotifyFd);
+    if (impl->wakePipe[0] >= 0)
+        close(impl->wakePipe[0]);
+    if (impl->wakePipe[1] >= 0)
+        close(impl->wakePipe[1]);
+#endif
+}
+
+void ShaderWatcher::add(WatchedShader shader) {
+    if (shader.options.sourcePath.empty())
+        shader.options.sourcePath = shader.path;
+
+    const auto key = canonical_shader_path(shader.path);
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->shaders[key] = std::move(shader);
+    }
+    // Registered up front so the shader is watched even if its first compile fails before the includes are known.
+    if (impl->graph.dependencies_of(key).empty())
+        impl->graph.set_dependencies(key, {});
+    impl->rebuild({ key });
+}
+
+void ShaderWatcher::remove(const fs::path& path) {
+    const auto key = canonical_shader_path(path);
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    impl->shaders.erase(key);
+    impl->graph.remove(key);
+}
+
+void ShaderWatcher::start() {
+    if (impl->running.exchange(true))
+        return;
+#ifdef __linux__
+    if (impl->inotifyFd < 0 || impl->wakePipe[0] < 0) {
+        impl->running = false;
+        throw std::runtime_error("inotify could not be initialized.");
+    }
+    // Drop a wake up left over from a previous stop().
+    char leftover;
+    while (read(impl->wakePipe[0], &leftover, 1) > 0) {}
+#endif
+    impl->sync_watches();
+    impl->thread = std::thread([this] { impl->run(); });
+}
+
+void ShaderWatcher::stop() {
+    if (!impl->running.exchange(false))
+        return;
+#ifdef __linux__
+    const char wake = 1;
+    (void)!write(impl->wakePipe[1], &wake, 1);
+#else
+    impl->sleep.notify_all();
+#endif
+    if (impl->thread.joinable())
+        impl->thread.join();
+}
+
+void ShaderWatcher::notify_changed(const fs::path& file) {
+    impl->rebuild(impl->graph.affected_shaders(canonical_shader_path(file)));
+}
+
+DependencyGraph& ShaderWatcher::graph() {
+    return impl->graph;
+}
+}
@@ -0,0 +1,129 @@
+/*
+* File: test_binary
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "test_common.hpp"
+#include "shader_binary.hpp"
+
+#include <cstring>
+
+using namespace shaderpipe;
+
+namespace {
+void round_trips_every_table() {
+    const auto shader = test::sample_shader();
+    const auto blob = write_shader_binary(shader);
+    CHECK(blob.size() % 4 == 0);
+
+    const auto view = ShaderBinaryView::from_bytes(blob);
+    CHECK(view.has_value());
+    if (!view)
+        return;
+
+    const auto copy = view->to_compiled_shader();
+    CHECK(copy.spirv == shader.spirv);
+    CHECK(test::same_reflection(copy.reflection, shader.reflection));
+}
+
+void views_read_in_place() {
+    const auto shader = test::sample_shader();
+    const auto blob = write_shader_binary(shader);
+    const auto view = ShaderBinaryView::from_bytes(blob);
+    CHECK(view.has_value());
+    if (!view)
+        return;
+
+    // Nothing is copied out, the SPIR-V span points into the blob.
+    const auto spirv = view->spirv();
+    CHECK(reinterpret_cast<const uint8_t*>(spirv.data()) >= blob.data());
+    CHECK(reinterpret_cast<const uint8_t*>(spirv.data() + spirv.size()) <= blob.data() + blob.size());
+
+    // Vertex input fields (format 4).
+    const auto inputs = view->inputs();
+    CHECK(inputs.size() == 3);
+    CHECK(inputs[1].name() == "model" && inputs[1].columns() == 4 && inputs[1].arraySize() == 2);
+    CHECK(inputs[2].baseType() == ScalarType::UINT && inputs[2].bitWidth() == 16);
+
+    // Spec constants keep all 64 bits, and a negative int default keeps its sign extension (format 5).
+    const auto specConstants = view->spec_constants();
+    CHECK(specConstants.size() == 3);
+    CHECK(specConstants[1].defaultValue() == static_cast<uint64_t>(int64_t(-1)));
+    CHECK(specConstants[2].defaultValue() == 0x0123456789abcdefull);
+
+    // Unused bindings (format 3), sharing their name with a used one through the string table.
+    const auto unused = view->unused_descriptor_bindings();
+    CHECK(unused.size() == 1);
+    CHECK(unused[0].name() == "camera" && unused[0].type() == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+    CHECK(unused[0].name().data() == view->descriptor_bindings()[0].name().data());
+
+    size_t bindings = 0;
+    for (const auto binding : view->descriptor_bindings())
+        bindings += binding.count();
+    CHECK(bindings == 4097);
+}
+
+void round_trips_an_empty_shader() {
+    const auto blob = write_shader_binary(CompiledShader{});
+    const auto view = ShaderBinaryView::from_bytes(blob);
+    CHECK(view.has_value());
+    if (!view)
+        return;
+    CHECK(view->spirv().empty());
+    CHECK(test::same_reflection(view->to_compiled_shader().reflection, ShaderReflection{}));
+}
+
+void rejects_damaged_blobs() {
+    const auto blob = write_shader_binary(test::sample_shader());
+
+    // Every truncation, down to an empty span.
+    bool anyAccepted = false;
+    for (size_t size = 0; size < blob.size(); size += 4)
+        anyAccepted |= ShaderBinaryView::from_bytes({ blob.data(), size }).has_value();
+    CHECK(!anyAccepted);
+
+    binary::Header header;
+    std::memcpy(&header, blob.data(), sizeof(header));
+
+    auto wrongVersion = blob;
+    const uint32_t oldVersion = binary::Version - 1;
+    std::memcpy(wrongVersion.data() + offsetof(binary::Header, version), &oldVersion, sizeof(oldVersion));
+    CHECK(!ShaderBinaryView::from_bytes(wrongVersion));
+
+    auto wrongMagic = blob;
+    wrongMagic[0] ^= 0xff;
+    CHECK(!ShaderBinaryView::from_bytes(wrongMagic));
+
+    // A table running past the end of the blob.
+    auto longTable = blob;
+    const uint32_t count = header.inputs.count + 1000;
+    std::memcpy(longTable.data() + offsetof(binary::Header, inputs) + offsetof(binary::Section, count), &count, sizeof(count));
+    CHECK(!ShaderBinaryView::from_bytes(longTable));
+
+    // A name pointing outside the string table.
+    auto badName = blob;
+    const uint32_t offset = header.strings.count;
+    std::memcpy(badName.data() + header.descriptorBindings.offset + offsetof(binary::DescriptorBinding, name), &offset, sizeof(offset));
+    CHECK(!ShaderBinaryView::from_bytes(badName));
+
+    // Blobs are read in place, a misaligned one is refused rather than read with unaligned loads.
+    std::vector<uint8_t> shifted(blob.size() + 4);
+    std::memcpy(shifted.data() + 1, blob.data(), blob.size());
+    CHECK(!ShaderBinaryView::from_bytes({ shifted.data() + 1, blob.size() }));
+}
+}
+
+int main() {
+    test::run("round_trips_every_table", round_trips_every_table);
+    test::run("views_read_in_place", views_read_in_place);
+    test::run("round_trips_an_empty_shader", round_trips_an_empty_shader);
+    test::run("rejects_damaged_blobs", rejects_damaged_blobs);
+    return test::result();
+}
@@ -0,0 +1,236 @@
+/*
+* File: test_canonical
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "test_common.hpp"
+#include "shader_canonical.hpp"
+#include "shader_optimizer.hpp"
+
+#include <spirv-tools/libspirv.hpp>
+
+#include <stdexcept>
+
+using namespace shaderpipe;
+
+namespace {
+// One compute shader, buf.value = plus_one(twice(buf.value)), spelled out in pieces so each test can change one.
+constexpr const char* Preamble = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint GLCompute %main "main"
+OpExecutionMode %main LocalSize 1 1 1
+)";
+
+constexpr const char* Names = R"(
+OpSource GLSL 450
+OpName %main "main"
+OpName %twice "twice"
+OpName %plus_one "plus_one"
+OpName %Block "Block"
+OpName %buf "buf"
+)";
+
+constexpr const char* Globals = R"(
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%float = OpTypeFloat 32
+%float_fn = OpTypeFunction %float %float
+%int = OpTypeInt 32 1
+%int_0 = OpConstant %int 0
+%float_1 = OpConstant %float 1
+%float_2 = OpConstant %float 2
+%Block = OpTypeStruct %float
+%ptr_Block = OpTypePointer Uniform %Block
+%ptr_float = OpTypePointer Uniform %float
+%buf = OpVariable %ptr_Block Uniform
+)";
+
+constexpr const char* Main = R"(
+%main = OpFunction %void None %void_fn
+%main_entry = OpLabel
+%p = OpAccessChain %ptr_float %buf %int_0
+%x = OpLoad %float %p
+%y = OpFunctionCall %float %twice %x
+%z = OpFunctionCall %float %plus_one %y
+OpStore %p %z
+OpReturn
+OpFunctionEnd
+)";
+
+constexpr const char* Twice = R"(
+%twice = OpFunction %float None %float_fn
+%a = OpFunctionParameter %float
+%twice_entry = OpLabel
+%r = OpFMul %float %a %float_2
+OpReturnValue %r
+OpFunctionEnd
+)";
+
+constexpr const char* PlusOne = R"(
+%plus_one = OpFunction %float None %float_fn
+%b = OpFunctionParameter %float
+%plus_one_entry = OpLabel
+%s = OpFAdd %float %b %float_1
+OpReturnValue %s
+OpFunctionEnd
+)";
+
+// Globals in another valid order.
+constexpr const char* ShuffledGlobals = R"(
+%int = OpTypeInt 32 1
+%int_0 = OpConstant %int 0
+%float = OpTypeFloat 32
+%float_2 = OpConstant %float 2
+%float_1 = OpConstant %float 1
+%void = OpTypeVoid
+%void_fn = OpTypeFunction %void
+%float_fn = OpTypeFunction %float %float
+%Block = OpTypeStruct %float
+%ptr_float = OpTypePointer Uniform %float
+%ptr_Block = OpTypePointer Uniform %Block
+%buf = OpVariable %ptr_Block Uniform
+)";
+
+struct Spelling {
+    std::string names = Names;
+    std::string globals = Globals;
+    std::string functions = std::string(Main) + Twice + PlusOne;
+    uint32_t binding = 0;
+};
+
+std::vector<uint32_t> assemble(const Spelling& spelling) {
+    const std::string text = std::string(Preamble) + spelling.names +
+                             "OpDecorate %Block BufferBlock\n"
+                             "OpMemberDecorate %Block 0 Offset 0\n"
+                             "OpDecorate %buf DescriptorSet 0\n"
+                             "OpDecorate %buf Binding " + std::to_string(spelling.binding) + "\n" +
+                             spelling.globals + spelling.functions;
+
+    std::vector<uint32_t> words;
+    spvtools::SpirvTools tools(SPV_ENV_VULKAN_1_0);
+    if (!tools.Assemble(text, &words))
+        throw std::runtime_error("test module failed to assemble");
+    return words;
+}
+
+CompiledShader compiled(const Spelling& spelling) {
+    auto spirv = assemble(spelling);
+    auto reflection = reflect_spirv(spirv);
+    return { std::move(spirv), std::move(reflection) };
+}
+
+std::string replaced(std::string text, std::string_view from, std::string_view to) {
+    const auto at = text.find(from);
+    if (at == std::string::npos)
+        throw std::runtime_error("nothing to replace");
+    return text.replace(at, from.size(), to);
+}
+
+Spelling renamed() {
+    Spelling s;
+    s.names = "OpName %main \"entry\"\nOpName %plus_one \"inc\"\nOpName %twice \"dbl\"\nOpName %buf \"data\"\n";
+    return s;
+}
+
+// The assembler numbers ids by first mention, so reordering names and declarations renumbers the module.
+Spelling renumbered() {
+    Spelling s;
+    s.names = "OpName %buf \"buf\"\nOpName %plus_one \"plus_one\"\nOpName %Block \"Block\"\nOpName %twice \"twice\"\n"
+              "OpName %main \"main\"\n";
+    s.globals = ShuffledGlobals;
+    return s;
+}
+
+Spelling reordered() {
+    Spelling s;
+    s.functions = std::string(PlusOne) + Main + Twice;
+    return s;
+}
+
+void equivalent_modules_canonicalize_identically() {
+    const auto base = assemble({});
+    const auto canonical = canonicalize_spirv(base);
+
+    for (const auto& [what, spelling] : { std::pair{ "names", renamed() }, std::pair{ "ids", renumbered() },
+                                          std::pair{ "function order", reordered() } }) {
+        const auto other = assemble(spelling);
+        // Has to differ going in, or the checks below prove nothing.
+        CHECK(other != base);
+        if (other == base)
+            std::fprintf(stderr, "%s: variant assembled to the same words\n", what);
+        CHECK(canonicalize_spirv(other) == canonical);
+        CHECK(canonical_shader_hash(compiled(spelling)) == canonical_shader_hash(compiled({})));
+    }
+}
+
+void different_modules_hash_differently() {
+    const auto base = compiled({});
+
+    Spelling constant;
+    constant.globals = replaced(Globals, "OpConstant %float 2", "OpConstant %float 3");
+    const auto otherConstant = compiled(constant);
+    CHECK(canonicalize_spirv(otherConstant.spirv) != canonicalize_spirv(base.spirv));
+    CHECK(canonical_shader_hash(otherConstant) != canonical_shader_hash(base));
+
+    Spelling decoration;
+    decoration.binding = 1;
+    const auto otherDecoration = compiled(decoration);
+    CHECK(canonicalize_spirv(otherDecoration.spirv) != canonicalize_spirv(base.spirv));
+    CHECK(canonical_shader_hash(otherDecoration) != canonical_shader_hash(base));
+
+    // The SPIR-V alone tells them apart too, not only the reflection.
+    CHECK(hash_reflection(otherConstant.reflection) == hash_reflection(base.reflection));
+}
+
+void canonical_modules_stay_valid() {
+    for (const auto& spelling : { Spelling{}, renamed(), renumbered(), reordered() }) {
+        const auto canonical = canonicalize_spirv(assemble(spelling));
+        std::string log;
+        CHECK(validate_spirv(canonical, VKVersion::VK_1_0, &log));
+        if (!log.empty())
+            std::fprintf(stderr, "%s\n", log.c_str());
+
+        // Already canonical, so a second pass changes nothing.
+        CHECK(canonicalize_spirv(canonical) == canonical);
+    }
+
+    // Cut off before the last OpFunctionEnd.
+    auto truncated = assemble({});
+    truncated.pop_back();
+    CHECK_THROWS(canonicalize_spirv(truncated));
+}
+
+void registry_shares_equivalent_shaders() {
+    ModuleRegistry registry;
+    const auto first = registry.add(compiled({}));
+    const auto second = registry.add(compiled(renamed()));
+    const auto third = registry.add(compiled(reordered()));
+    CHECK(first.inserted && !second.inserted && !third.inserted);
+    CHECK(second.shader == first.shader && third.shader == first.shader);
+    CHECK(registry.size() == 1);
+    CHECK(registry.duplicates() == 2);
+
+    Spelling decoration;
+    decoration.binding = 1;
+    const auto other = registry.add(compiled(decoration));
+    CHECK(other.inserted && other.shader != first.shader);
+    CHECK(registry.size() == 2);
+    CHECK(registry.find(first.hash) == first.shader);
+}
+}
+
+int main() {
+    test::run("equivalent_modules_canonicalize_identically", equivalent_modules_canonicalize_identically);
+    test::run("different_modules_hash_differently", different_modules_hash_differently);
+    test::run("canonical_modules_stay_valid", canonical_modules_stay_valid);
+    test::run("registry_shares_equivalent_shaders", registry_shares_equivalent_shaders);
+    return test::result();
+}
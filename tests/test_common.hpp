@@ -0,0 +1,153 @@
+/*
+* File: test_common
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#ifndef SHADER_PIPE_TEST_COMMON_HPP
+#define SHADER_PIPE_TEST_COMMON_HPP
+
+#include "shader_pipe.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <string>
+
+// Just enough of a test harness to keep the tests free of dependencies: every test file is its own executable,
+// run by ctest, and fails when any CHECK in it fails or a test throws.
+namespace shaderpipe::test {
+
+inline int failures = 0;
+
+inline void check(bool ok, const char* what, const char* file, int line) {
+    if (ok)
+        return;
+    ++failures;
+    std::fprintf(stderr, "%s:%d: %s failed\n", file, line, what);
+}
+
+inline void run(const char* name, const std::function<void()>& test) {
+    const int before = failures;
+    try {
+        test();
+    } catch (const std::exception& e) {
+        ++failures;
+        std::fprintf(stderr, "%s: threw: %s\n", name, e.what());
+    }
+    std::printf("%s %s\n", failures == before ? "[ ok ]" : "[fail]", name);
+}
+
+inline int result() {
+    return failures == 0 ? 0 : 1;
+}
+
+// Field by field, the reflection structs have no operator== of their own.
+inline bool same_binding(const DescriptorBindingInfo& a, const DescriptorBindingInfo& b) {
+    return a.set == b.set && a.binding == b.binding && a.name == b.name && a.type == b.type && a.count == b.count &&
+           a.stageFlags == b.stageFlags;
+}
+
+inline bool same_attribute(const InputAttributeInfo& a, const InputAttributeInfo& b) {
+    return a.location == b.location && a.name == b.name && a.vecSize == b.vecSize && a.bitWidth == b.bitWidth &&
+           a.baseType == b.baseType && a.columns == b.columns && a.arraySize == b.arraySize;
+}
+
+template<typename T, typename Same>
+bool same_table(const std::vector<T>& a, const std::vector<T>& b, Same same) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!same(a[i], b[i]))
+            return false;
+    }
+    return true;
+}
+
+inline bool same_reflection(const ShaderReflection& a, const ShaderReflection& b) {
+    return same_table(a.descriptorBindings, b.descriptorBindings, same_binding) &&
+           same_table(a.unusedDescriptorBindings, b.unusedDescriptorBindings, same_binding) &&
+           same_table(a.pushConstants, b.pushConstants, [](const PushConstantInfo& x, const PushConstantInfo& y) {
+               return x.offset == y.offset && x.size == y.size && x.stageFlags == y.stageFlags;
+           }) &&
+           same_table(a.inputs, b.inputs, same_attribute) &&
+           same_table(a.outputs, b.outputs, same_attribute) &&
+           same_table(a.specConstants, b.specConstants, [](const SpecConstantInfo& x, const SpecConstantInfo& y) {
+               return x.constantId == y.constantId && x.name == y.name && x.type == y.type && x.bitWidth == y.bitWidth &&
+                      x.defaultValue == y.defaultValue;
+           });
+}
+
+// Every table filled in, names shared between tables, values that need the full width of their fields. The SPIR-V
+// is only well formed at the instruction level (header, then word count / opcode framed instructions), which is all
+// the binary and pack formats look at.
+inline CompiledShader sample_shader() {
+    CompiledShader shader;
+    shader.spirv = {
+        0x07230203, 0x00010300, 0x00080001, 200, 0,   // header, bound 200
+        (2u << 16) | 17, 1,                            // OpCapability Shader
+        (3u << 16) | 14, 0, 1,                         // OpMemoryModel Logical GLSL450
+        (4u << 16) | 5, 199, 0x6d6f6f62, 0,            // OpName %199 "boom"
+        (5u << 16) | 43, 7, 0xffffffff, 0x80000000, 0, // a constant with words that need every varint byte
+    };
+
+    auto& r = shader.reflection;
+    r.descriptorBindings = {
+        { 0, 0, "camera", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT },
+        { 3, 17, "textures", VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4096, VK_SHADER_STAGE_FRAGMENT_BIT },
+    };
+    r.unusedDescriptorBindings = {
+        { 1, 2, "camera", VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT },
+    };
+    r.pushConstants = { { 16, 64, VK_SHADER_STAGE_FRAGMENT_BIT } };
+    r.inputs = {
+        { 0, "position", 3, 32, ScalarType::FLOAT, 1, 1 },
+        { 1, "model", 4, 32, ScalarType::FLOAT, 4, 2 },
+        { 9, "joints", 4, 16, ScalarType::UINT, 1, 1 },
+    };
+    r.outputs = { { 0, "color", 4, 32, ScalarType::FLOAT, 1, 1 } };
+    r.specConstants = {
+        { 0, "use_shadows", ScalarType::BOOL, 32, 1 },
+        { 1, "bias", ScalarType::INT, 32, static_cast<uint64_t>(int64_t(-1)) },
+        { 7, "seed", ScalarType::UINT, 64, 0x0123456789abcdefull },
+    };
+    return shader;
+}
+
+// Fresh directory under the system temp directory, removed again when it goes out of scope.
+class TempDir {
+public:
+    TempDir() {
+        path = std::filesystem::temp_directory_path() / ("shaderpipe_test_" + std::to_string(std::random_device{}()));
+        std::filesystem::create_directories(path);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    TempDir(const TempDir&) = delete;
+    TempDir& operator=(const TempDir&) = delete;
+
+    std::filesystem::path path;
+};
+}
+
+#define CHECK(expression) ::shaderpipe::test::check(static_cast<bool>(expression), "CHECK(" #expression ")", __FILE__, __LINE__)
+
+#define CHECK_THROWS(expression)                                                                \
+    do {                                                                                        \
+        bool threw_ = false;                                                                    \
+        try { (void)(expression); } catch (const std::exception&) { threw_ = true; }            \
+        ::shaderpipe::test::check(threw_, "CHECK_THROWS(" #expression ")", __FILE__, __LINE__); \
+    } while (0)
+
+#endif //SHADER_PIPE_TEST_COMMON_HPP
@@ -0,0 +1,200 @@
+/*
+* File: test_pack
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "test_common.hpp"
+#include "shader_pack.hpp"
+
+#include <cstring>
+#include <fstream>
+
+using namespace shaderpipe;
+
+namespace {
+// Where things sit in a serialized pack, see the layout comment in shader_pack.cpp.
+constexpr size_t HeaderSize = 16;
+constexpr size_t IndexEntrySize = 56;
+constexpr size_t SpirvOffsetField = 40;
+constexpr size_t SpirvSizeField = 44;
+constexpr size_t SpirvWordsField = 48;
+
+// Neither option touches the words, so what comes back has to be exactly what went in.
+constexpr ShaderPackOptions Verbatim{ false, false };
+
+ShaderHash key(std::string_view name) {
+    Hasher h;
+    h.update(name);
+    return h.finish();
+}
+
+void save(const std::filesystem::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void put_u32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+uint32_t get_u32(const std::vector<uint8_t>& bytes, size_t offset) {
+    uint32_t value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    return value;
+}
+
+void round_trips_entries() {
+    test::TempDir dir;
+    const auto path = dir.path / "shaders.pack";
+
+    auto first = test::sample_shader();
+    auto second = test::sample_shader();
+    second.spirv.push_back((2u << 16) | 17);
+    second.spirv.push_back(0x7fffffff);
+    second.reflection.descriptorBindings.pop_back();
+
+    ShaderPackWriter writer(Verbatim);
+    writer.add(key("first"), first);
+    writer.add(key("second"), test::sample_shader());
+    writer.add(key("second"), second); // replaces the one before
+    CHECK(writer.size() == 2);
+    CHECK(writer.write(path));
+
+    // Nothing left next to the pack from the temp file it was written through.
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir.path))
+        files += entry.is_regular_file();
+    CHECK(files == 1);
+
+    ShaderPack pack;
+    CHECK(pack.open(path));
+    CHECK(pack.size() == 2);
+    CHECK(pack.contains(key("first")));
+    CHECK(!pack.contains(key("third")));
+    CHECK(!pack.load(key("third")));
+
+    const std::pair<const char*, const CompiledShader*> expected[] = { { "first", &first }, { "second", &second } };
+    for (const auto& [name, shader] : expected) {
+        const auto loaded = pack.load(key(name));
+        CHECK(loaded.has_value());
+        if (!loaded)
+            continue;
+        CHECK(loaded->spirv == shader->spirv);
+        CHECK(test::same_reflection(loaded->reflection, shader->reflection));
+
+        const auto view = pack.reflection(key(name));
+        CHECK(view.has_value() && view->spirv().empty());
+    }
+}
+
+void compacted_entries_still_decode() {
+    test::TempDir dir;
+    const auto path = dir.path / "compact.pack";
+
+    // Default options strip and compact through spirv-opt, so this one needs a real module.
+    const std::vector<uint32_t> module = {
+        0x07230203, 0x00010000, 0, 5, 0,
+        (2u << 16) | 17, 1,                     // OpCapability Shader
+        (3u << 16) | 14, 0, 1,                  // OpMemoryModel Logical GLSL450
+        (5u << 16) | 15, 5, 1, 0x6e69616d, 0,   // OpEntryPoint GLCompute %1 "main"
+        (6u << 16) | 16, 1, 17, 1, 1, 1,        // OpExecutionMode %1 LocalSize 1 1 1
+        (4u << 16) | 5, 1, 0x6e69616d, 0,       // OpName %1 "main"
+        (2u << 16) | 19, 2,                     // %2 = OpTypeVoid
+        (3u << 16) | 33, 3, 2,                  // %3 = OpTypeFunction %2
+        (5u << 16) | 54, 2, 1, 0, 3,            // %1 = OpFunction %2 None %3
+        (2u << 16) | 248, 4,                    // %4 = OpLabel
+        (1u << 16) | 253,                       // OpReturn
+        (1u << 16) | 56,                        // OpFunctionEnd
+    };
+
+    ShaderPackWriter writer;
+    writer.add(key("compute"), CompiledShader{ module, {} });
+    CHECK(writer.write(path));
+
+    ShaderPack pack;
+    CHECK(pack.open(path));
+    const auto spirv = pack.load_spirv(key("compute"));
+    CHECK(spirv.has_value());
+    if (!spirv)
+        return;
+    // OpName is gone, everything else is still there.
+    CHECK(spirv->size() == module.size() - 4);
+    CHECK((*spirv)[0] == 0x07230203);
+}
+
+void rejects_damaged_packs() {
+    test::TempDir dir;
+    const auto path = dir.path / "damaged.pack";
+
+    ShaderPackWriter writer(Verbatim);
+    writer.add(key("only"), test::sample_shader());
+    const auto good = writer.serialize();
+    const size_t entry = HeaderSize;
+
+    ShaderPack pack;
+
+    // Truncated header and truncated index.
+    save(path, { good.begin(), good.begin() + 8 });
+    CHECK(!pack.open(path));
+    save(path, { good.begin(), good.begin() + HeaderSize + IndexEntrySize / 2 });
+    CHECK(!pack.open(path));
+
+    // Not a pack at all.
+    auto foreign = good;
+    foreign[0] ^= 0xff;
+    save(path, foreign);
+    CHECK(!pack.open(path));
+
+    // An entry whose SPIR-V runs past the end of the file reads as missing.
+    auto pastEnd = good;
+    put_u32(pastEnd, entry + SpirvOffsetField, static_cast<uint32_t>(good.size()));
+    save(path, pastEnd);
+    CHECK(pack.open(path));
+    CHECK(!pack.contains(key("only")));
+    CHECK(!pack.load(key("only")));
+
+    // A word count no encoding could produce must not turn into a huge allocation.
+    auto hugeCount = good;
+    put_u32(hugeCount, entry + SpirvWordsField, 0xffffffff);
+    save(path, hugeCount);
+    CHECK(pack.open(path));
+    CHECK(pack.contains(key("only")));
+    CHECK(!pack.load_spirv(key("only")));
+    CHECK(!pack.load(key("only")));
+
+    // A count that is merely off by one.
+    auto shortCount = good;
+    put_u32(shortCount, entry + SpirvWordsField, get_u32(good, entry + SpirvWordsField) - 1);
+    save(path, shortCount);
+    CHECK(pack.open(path));
+    CHECK(!pack.load_spirv(key("only")));
+
+    // Every byte of the encoded SPIR-V set to a varint continuation byte.
+    auto garbage = good;
+    const auto spirvOffset = get_u32(good, entry + SpirvOffsetField);
+    const auto spirvSize = get_u32(good, entry + SpirvSizeField);
+    std::memset(garbage.data() + spirvOffset, 0x80, spirvSize);
+    save(path, garbage);
+    CHECK(pack.open(path));
+    CHECK(!pack.load_spirv(key("only")));
+
+    // The undamaged pack still loads, so the checks above failed for the right reason.
+    save(path, good);
+    CHECK(pack.open(path));
+    CHECK(pack.load(key("only")).has_value());
+}
+}
+
+int main() {
+    test::run("round_trips_entries", round_trips_entries);
+    test::run("compacted_entries_still_decode", compacted_entries_still_decode);
+    test::run("rejects_damaged_packs", rejects_damaged_packs);
+    return test::result();
+}
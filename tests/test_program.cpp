@@ -0,0 +1,125 @@
+/*
+* File: test_program
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "test_common.hpp"
+#include "shader_program.hpp"
+
+using namespace shaderpipe;
+
+namespace {
+DescriptorBindingInfo binding(uint32_t set, uint32_t index, std::string name, VkDescriptorType type, uint32_t count,
+                              VkShaderStageFlags stages) {
+    return { set, index, std::move(name), type, count, stages };
+}
+
+void merges_shared_bindings() {
+    ShaderReflection vertex;
+    vertex.descriptorBindings = {
+        binding(0, 0, "camera", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT),
+        binding(1, 2, "bones", VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT),
+    };
+    ShaderReflection fragment;
+    fragment.descriptorBindings = {
+        binding(1, 0, "albedo", VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4, VK_SHADER_STAGE_FRAGMENT_BIT),
+        binding(0, 0, "view", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT),
+    };
+
+    const ShaderReflection stages[] = { vertex, fragment };
+    const auto program = reflect_program(stages);
+
+    CHECK(program.stages == (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+    CHECK(program.setLayouts.size() == 2);
+    if (program.setLayouts.size() != 2)
+        return;
+
+    // Set 0: one binding both stages read, under two different names.
+    const auto& set0 = program.setLayouts[0];
+    CHECK(set0.set == 0);
+    CHECK(set0.bindings.size() == 1);
+    CHECK(set0.bindings[0].stageFlags == (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT));
+
+    // Set 1: sorted by binding, whatever order the stages listed them in.
+    const auto& set1 = program.setLayouts[1];
+    CHECK(set1.set == 1);
+    CHECK(set1.bindings.size() == 2);
+    CHECK(set1.bindings[0].binding == 0 && set1.bindings[0].count == 4);
+    CHECK(set1.bindings[1].binding == 2 && set1.bindings[1].type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER);
+
+    CHECK(set0.hash == hash_set_layout(set0.bindings));
+    CHECK(set1.hash == hash_set_layout(set1.bindings));
+}
+
+void rejects_conflicting_bindings() {
+    ShaderReflection vertex;
+    vertex.descriptorBindings = { binding(0, 0, "a", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT) };
+
+    ShaderReflection otherType;
+    otherType.descriptorBindings = { binding(0, 0, "a", VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT) };
+    const ShaderReflection typeMismatch[] = { vertex, otherType };
+    CHECK_THROWS(reflect_program(typeMismatch));
+
+    ShaderReflection otherCount;
+    otherCount.descriptorBindings = { binding(0, 0, "a", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 2, VK_SHADER_STAGE_FRAGMENT_BIT) };
+    const ShaderReflection countMismatch[] = { vertex, otherCount };
+    CHECK_THROWS(reflect_program(countMismatch));
+}
+
+void merges_push_constant_ranges() {
+    ShaderReflection vertex;
+    vertex.pushConstants = { { 0, 64, VK_SHADER_STAGE_VERTEX_BIT } };
+    ShaderReflection fragment;
+    fragment.pushConstants = { { 64, 16, VK_SHADER_STAGE_FRAGMENT_BIT }, { 96, 16, VK_SHADER_STAGE_FRAGMENT_BIT } };
+    ShaderReflection geometry;
+    geometry.pushConstants = { { 0, 64, VK_SHADER_STAGE_GEOMETRY_BIT } };
+
+    const ShaderReflection stages[] = { vertex, fragment, geometry };
+    const auto program = reflect_program(stages);
+
+    // Vulkan allows a stage in one range only: the fragment stage's two blocks become one, and stages reading the
+    // same bytes share a range.
+    CHECK(program.pushConstants.size() == 2);
+    if (program.pushConstants.size() != 2)
+        return;
+    CHECK(program.pushConstants[0].offset == 0 && program.pushConstants[0].size == 64);
+    CHECK(program.pushConstants[0].stageFlags == (VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT));
+    CHECK(program.pushConstants[1].offset == 64 && program.pushConstants[1].size == 48);
+    CHECK(program.pushConstants[1].stageFlags == VK_SHADER_STAGE_FRAGMENT_BIT);
+}
+
+void set_layout_hash_ignores_names_and_order() {
+    const DescriptorBindingInfo a[] = {
+        binding(0, 0, "camera", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT),
+        binding(0, 1, "albedo", VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT),
+    };
+    const DescriptorBindingInfo b[] = {
+        binding(0, 1, "diffuse", VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT),
+        binding(0, 0, "view", VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT),
+    };
+    CHECK(hash_set_layout(a) == hash_set_layout(b));
+
+    auto moreStages = std::vector<DescriptorBindingInfo>(std::begin(a), std::end(a));
+    moreStages[0].stageFlags |= VK_SHADER_STAGE_FRAGMENT_BIT;
+    CHECK(hash_set_layout(moreStages) != hash_set_layout(a));
+
+    auto moreDescriptors = std::vector<DescriptorBindingInfo>(std::begin(a), std::end(a));
+    moreDescriptors[1].count = 8;
+    CHECK(hash_set_layout(moreDescriptors) != hash_set_layout(a));
+}
+}
+
+int main() {
+    test::run("merges_shared_bindings", merges_shared_bindings);
+    test::run("rejects_conflicting_bindings", rejects_conflicting_bindings);
+    test::run("merges_push_constant_ranges", merges_push_constant_ranges);
+    test::run("set_layout_hash_ignores_names_and_order", set_layout_hash_ignores_names_and_order);
+    return test::result();
+}
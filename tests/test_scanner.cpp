@@ -0,0 +1,201 @@
+/*
+* File: test_scanner
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "test_common.hpp"
+#include "shader_scanner.hpp"
+#include "shader_dependency_graph.hpp"
+#include "shader_thread_pool.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace shaderpipe;
+
+namespace fs = std::filesystem;
+
+namespace {
+void write_file(const fs::path& path, std::string_view contents) {
+    fs::create_directories(path.parent_path());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+}
+
+std::string escaped(std::string_view path) {
+    std::string out;
+    for (const char c : path) {
+        if (c == ' ' || c == '#')
+            out += '\\';
+        else if (c == '$')
+            out += '$';
+        out += c;
+    }
+    return out;
+}
+
+// shader dir/main.frag
+//   "common.glsl"        -> shader dir/common.glsl -> <lib/math.glsl>
+//   <lib/math.glsl>      -> include dir/lib/math.glsl (again, listed once)
+//   "missing.glsl"       -> nowhere
+// The spaces are there to exercise the depfile escaping.
+struct Tree {
+    Tree() {
+        shaders = dir.path / "shader dir";
+        includes = dir.path / "include dir";
+        write_file(shaders / "main.frag",
+                   "#version 450 core\n"
+                   "#extension GL_GOOGLE_include_directive : require\n"
+                   "#include \"common.glsl\"\n"
+                   "// #include \"commented_out.glsl\"\n"
+                   "/* #include \"also_commented_out.glsl\" */\n"
+                   "#include <lib/math.glsl>\n"
+                   "#include \"missing.glsl\"\n"
+                   "void main() {}\n");
+        write_file(shaders / "common.glsl",
+                   "#extension GL_EXT_samplerless_texture_functions : enable\n"
+                   "#include <lib/math.glsl>\n");
+        write_file(includes / "lib" / "math.glsl",
+                   "#extension GL_GOOGLE_include_directive : require\n"
+                   "float square(float x) { return x * x; }\n");
+    }
+
+    test::TempDir dir;
+    fs::path shaders;
+    fs::path includes;
+};
+
+void scans_directives() {
+    const auto info = scan_shader(
+        "// #version 100\n"
+        "  #  version 460 core // trailing comment\n"
+        "#extension GL_EXT_ray_query : require\n"
+        "/* #include \"skipped.glsl\" */ #include \"a.glsl\"\n"
+        "int x; #include \"not_a_directive.glsl\"\n"
+        "#include <b.glsl>\n"
+        "#pragma shader_stage(compute)\n");
+
+    CHECK(info.version == 460);
+    CHECK(info.profile == "core");
+    CHECK(info.extensions.size() == 1 && info.extensions[0].name == "GL_EXT_ray_query" && info.extensions[0].behavior == "require");
+    CHECK(info.includes.size() == 2);
+    if (info.includes.size() == 2) {
+        CHECK(info.includes[0].name == "a.glsl" && !info.includes[0].system && info.includes[0].line == 4);
+        CHECK(info.includes[1].name == "b.glsl" && info.includes[1].system && info.includes[1].line == 6);
+    }
+    CHECK(info.stage == ShaderStage::COMPUTE);
+
+    CHECK(stage_from_extension("shadow.vert.glsl") == ShaderStage::VERTEX);
+    CHECK(stage_from_extension("hit.rchit") == ShaderStage::CLOSEST_HIT);
+    CHECK(!stage_from_extension("common.glsl"));
+}
+
+void resolves_includes_transitively() {
+    Tree tree;
+    DependencyScanner scanner({ tree.includes });
+    const auto deps = scanner.scan(tree.shaders / "main.frag");
+
+    CHECK(deps.path == canonical_shader_path(tree.shaders / "main.frag"));
+    CHECK(deps.info.stage == ShaderStage::FRAGMENT);
+    CHECK(deps.error.empty());
+
+    const std::vector<std::string> expected = {
+        canonical_shader_path(tree.shaders / "common.glsl"),
+        canonical_shader_path(tree.includes / "lib" / "math.glsl"),
+    };
+    CHECK(deps.includes == expected);
+    CHECK(deps.missing == std::vector<std::string>{ "missing.glsl" });
+
+    // First occurrence of each name, in discovery order.
+    CHECK(deps.extensions.size() == 2);
+    if (deps.extensions.size() == 2) {
+        CHECK(deps.extensions[0].name == "GL_GOOGLE_include_directive");
+        CHECK(deps.extensions[1].name == "GL_EXT_samplerless_texture_functions");
+    }
+
+    CHECK_THROWS(scanner.scan(tree.shaders / "does_not_exist.frag"));
+}
+
+void writes_depfiles() {
+    Tree tree;
+    DependencyScanner scanner({ tree.includes });
+    const auto deps = scanner.scan(tree.shaders / "main.frag");
+
+    const std::string target = "out dir/main.frag.spv";
+    const std::string expected =
+        escaped(target) + ": " + escaped(deps.path) + " \\\n  " +
+        escaped(canonical_shader_path(tree.shaders / "common.glsl")) + " \\\n  " +
+        escaped(canonical_shader_path(tree.includes / "lib" / "math.glsl")) + "\n";
+    CHECK(make_depfile(target, deps) == expected);
+
+    const auto depfile = tree.dir.path / "main.frag.d";
+    CHECK(write_depfile(depfile, target, deps));
+    std::ifstream in(depfile, std::ios::binary);
+    std::stringstream written;
+    written << in.rdbuf();
+    CHECK(written.str() == expected);
+
+    ShaderDependencies special;
+    special.path = "a#b$c d";
+    CHECK(make_depfile("t", special) == "t: a\\#b$$c\\ d\n");
+}
+
+void scan_all_reports_failures() {
+    Tree tree;
+    DependencyScanner scanner({ tree.includes });
+
+    const fs::path shaders[] = {
+        tree.shaders / "main.frag",
+        tree.shaders / "does_not_exist.frag",
+        tree.shaders / "main.frag",
+    };
+    ThreadPool pool(2);
+    const auto results = scanner.scan_all(shaders, pool);
+
+    CHECK(results.size() == 3);
+    if (results.size() != 3)
+        return;
+    CHECK(results[0].error.empty() && results[0].includes.size() == 2);
+    CHECK(results[2].includes == results[0].includes);
+
+    // Still names the shader, so its depfile depends on the file that is missing.
+    CHECK(!results[1].error.empty());
+    CHECK(results[1].error.find("does_not_exist.frag") != std::string::npos);
+    CHECK(results[1].path == canonical_shader_path(shaders[1]));
+    CHECK(results[1].includes.empty());
+    CHECK(make_depfile("x.spv", results[1]) == "x.spv: " + escaped(results[1].path) + "\n");
+}
+
+void clear_picks_up_changed_headers() {
+    Tree tree;
+    DependencyScanner scanner({ tree.includes });
+    CHECK(scanner.scan(tree.shaders / "main.frag").includes.size() == 2);
+
+    write_file(tree.shaders / "common.glsl", "#include \"extra.glsl\"\n");
+    write_file(tree.shaders / "extra.glsl", "\n");
+
+    // Headers are cached until clear().
+    CHECK(scanner.scan(tree.shaders / "main.frag").includes.size() == 2);
+    scanner.clear();
+    const auto deps = scanner.scan(tree.shaders / "main.frag");
+    CHECK(deps.includes.size() == 3);
+    CHECK(std::find(deps.includes.begin(), deps.includes.end(), canonical_shader_path(tree.shaders / "extra.glsl")) != deps.includes.end());
+}
+}
+
+int main() {
+    test::run("scans_directives", scans_directives);
+    test::run("resolves_includes_transitively", resolves_includes_transitively);
+    test::run("writes_depfiles", writes_depfiles);
+    test::run("scan_all_reports_failures", scan_all_reports_failures);
+    test::run("clear_picks_up_changed_headers", clear_picks_up_changed_headers);
+    return test::result();
+}
@@ -0,0 +1,119 @@
+/*
+* File: test_variants
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+#include "test_common.hpp"
+#include "shader_variants.hpp"
+
+using namespace shaderpipe;
+
+namespace {
+constexpr const char* Source = R"(#version 450
+layout(location = 0) out vec4 outColor;
+void main() {
+#ifdef RED
+    outColor = vec4(1.0, 0.0, 0.0, 1.0);
+#else
+    outColor = vec4(0.0, 0.0, 1.0, 1.0);
+#endif
+#ifdef BROKEN
+    #error broken permutation
+#endif
+}
+)";
+
+void unused_switches_share_a_module() {
+    const DefineAxis axes[] = { DefineAxis::toggle("RED"), DefineAxis::toggle("UNUSED") };
+    const auto set = compile_variants(default_compiler(), Source, ShaderStage::FRAGMENT, VKVersion::VK_1_3, axes);
+
+    CHECK(set.permutation_count() == 4);
+    CHECK(set.errors.empty());
+    CHECK(set.modules.size() == 2);
+    CHECK(set.moduleHashes.size() == set.modules.size());
+    if (set.modules.size() != 2)
+        return;
+    CHECK(set.moduleHashes[0] != set.moduleHashes[1]);
+
+    const uint32_t blue[] = { 0, 0 };
+    const uint32_t blueUnused[] = { 0, 1 };
+    const uint32_t red[] = { 1, 0 };
+    const uint32_t redUnused[] = { 1, 1 };
+    const auto module = [&](std::span<const uint32_t> choices) { return set.permutationModules[set.permutation_index(choices)]; };
+
+    CHECK(module(blue) == module(blueUnused));
+    CHECK(module(red) == module(redUnused));
+    CHECK(module(blue) != module(red));
+
+    // Same answer as compiling the permutation on its own.
+    CompileOptions redOptions;
+    redOptions.defines = { { "RED", "" } };
+    const auto direct = default_compiler().glsl_to_spirv(Source, ShaderStage::FRAGMENT, VKVersion::VK_1_3, redOptions);
+    CHECK(set.find(set.permutation_index(red))->spirv == direct);
+}
+
+void failed_permutations_are_reported() {
+    const DefineAxis axes[] = { DefineAxis::toggle("RED"), DefineAxis::toggle("BROKEN") };
+    const auto set = compile_variants(default_compiler(), Source, ShaderStage::FRAGMENT, VKVersion::VK_1_3, axes);
+
+    CHECK(set.permutation_count() == 4);
+    CHECK(set.modules.size() == 2);
+    CHECK(set.errors.size() == 2);
+
+    for (uint32_t red = 0; red < 2; ++red) {
+        const uint32_t working[] = { red, 0 };
+        const uint32_t broken[] = { red, 1 };
+        CHECK(set.find(set.permutation_index(working)) != nullptr);
+        CHECK(set.find(set.permutation_index(broken)) == nullptr);
+        CHECK(set.permutationModules[set.permutation_index(broken)] == VariantSet::InvalidModule);
+    }
+
+    // Sorted by permutation, the error names the failing line.
+    for (size_t i = 0; i < set.errors.size(); ++i) {
+        CHECK(set.errors[i].second.find("broken permutation") != std::string::npos);
+        if (i > 0)
+            CHECK(set.errors[i - 1].first < set.errors[i].first);
+    }
+
+    const uint32_t outOfRange[] = { 2, 0 };
+    CHECK_THROWS(set.permutation_index(outOfRange));
+}
+
+void identical_spirv_from_different_text_is_stored_once() {
+    constexpr const char* Folded = R"(#version 450
+layout(location = 0) out vec4 outColor;
+void main() {
+#ifdef SPELLED_OUT
+    outColor = vec4(0.5 + 0.5);
+#else
+    outColor = vec4(1.0);
+#endif
+}
+)";
+
+    // The preprocessed text differs, so both get compiled, but the front end folds the sum to the same constant.
+    const std::vector<std::vector<ShaderDefine>> permutations = { {}, { { "SPELLED_OUT", "" } } };
+    const auto set = compile_variants(default_compiler(), Folded, ShaderStage::FRAGMENT, VKVersion::VK_1_3,
+                                      std::span<const std::vector<ShaderDefine>>(permutations));
+
+    CHECK(set.errors.empty());
+    CHECK(set.modules.size() == 1);
+    CHECK(set.permutationModules.size() == 2);
+    CHECK(set.permutationModules[0] == 0 && set.permutationModules[1] == 0);
+    CHECK(set.axisSizes.empty());
+}
+}
+
+int main() {
+    test::run("unused_switches_share_a_module", unused_switches_share_a_module);
+    test::run("failed_permutations_are_reported", failed_permutations_are_reported);
+    test::run("identical_spirv_from_different_text_is_stored_once", identical_spirv_from_different_text_is_stored_once);
+    return test::result();
+}
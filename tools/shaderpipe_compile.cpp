@@ -0,0 +1,129 @@
+/*
+* File: shaderpipe_compile
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+// Command line compiler for build systems. Goes through a running shaderpipe_daemon when there is one and compiles
+// in-process otherwise, the output is the same either way. The stage comes from --stage, a #pragma shader_stage or
+// the file extension, in that order.
+//
+// usage: shaderpipe_compile <input> -o <output> [--stage <ext>] [--target <1.0..1.4>] [-I <dir>] [-D <name>[=<value>]]
+//                           [-O | -Os] [--binary] [--depfile <file>] [--socket <path>]
+//   --binary writes a shader binary (SPIR-V + reflection, see shader_binary.hpp) instead of plain SPIR-V.
+//   --depfile writes a Make / Ninja depfile listing every header the shader includes.
+
+#include "shader_daemon.hpp"
+#include "shader_binary.hpp"
+#include "shader_scanner.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace shaderpipe;
+
+namespace {
+std::optional<VKVersion> parse_target(const std::string& target) {
+    constexpr const char* Names[] = { "1.0", "1.1", "1.2", "1.3", "1.4" };
+    for (uint32_t i = 0; i < std::size(Names); ++i) {
+        if (target == Names[i])
+            return static_cast<VKVersion>(i);
+    }
+    return std::nullopt;
+}
+
+int usage() {
+    std::cerr << "usage: shaderpipe_compile <input> -o <output> [--stage <ext>] [--target <1.0..1.4>] [-I <dir>] [-D <name>[=<value>]]\n"
+                 "                          [-O | -Os] [--binary] [--depfile <file>] [--socket <path>]\n";
+    return 2;
+}
+}
+
+int main(int argc, char** argv) {
+    std::string input, output, socket, depfile;
+    std::optional<ShaderStage> stage;
+    VKVersion target = VKVersion::VK_1_3;
+    CompileOptions options;
+    bool binaryOutput = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue)
+            output = argv[++i];
+        else if (arg == "--stage" && hasValue) {
+            if (!(stage = stage_from_extension(std::string("x.") + argv[++i])))
+                return usage();
+        } else if (arg == "--target" && hasValue) {
+            auto version = parse_target(argv[++i]);
+            if (!version)
+                return usage();
+            target = *version;
+        } else if (arg == "-I" && hasValue)
+            options.includeDirectories.emplace_back(argv[++i]);
+        else if (arg == "-D" && hasValue) {
+            const std::string define = argv[++i];
+            const auto eq = define.find('=');
+            options.defines.push_back({ define.substr(0, eq), eq == std::string::npos ? std::string() : define.substr(eq + 1) });
+        } else if (arg == "-O")
+            options.optimization.level = OptimizationLevel::PERFORMANCE;
+        else if (arg == "-Os")
+            options.optimization.level = OptimizationLevel::SIZE;
+        else if (arg == "--binary")
+            binaryOutput = true;
+        else if (arg == "--depfile" && hasValue)
+            depfile = argv[++i];
+        else if (arg == "--socket" && hasValue)
+            socket = argv[++i];
+        else if (input.empty() && !arg.empty() && arg[0] != '-')
+            input = arg;
+        else
+            return usage();
+    }
+    if (input.empty() || output.empty())
+        return usage();
+
+    try {
+        // Scanned up front: it is cheap, finds a #pragma shader_stage and the depfile needs it anyway.
+        const auto deps = DependencyScanner(options.includeDirectories).scan(input);
+        if (!stage && !(stage = deps.info.stage)) {
+            std::cerr << "Can not tell the shader stage of " << input << ", pass --stage.\n";
+            return 2;
+        }
+
+        options.sourcePath = input;
+        const auto source = load_shader_file(input);
+
+        DaemonClient client(socket);
+        const auto shader = client.glsl_to_spirv_with_reflection(source, *stage, target, options);
+
+        std::ofstream out(output, std::ios::binary | std::ios::trunc);
+        if (binaryOutput) {
+            const auto bytes = write_shader_binary(shader);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        } else {
+            out.write(reinterpret_cast<const char*>(shader.spirv.data()), static_cast<std::streamsize>(shader.spirv.size() * sizeof(uint32_t)));
+        }
+        if (!out.good()) {
+            std::cerr << "Could not write " << output << "\n";
+            return 1;
+        }
+        if (!depfile.empty() && !write_depfile(depfile, output, deps)) {
+            std::cerr << "Could not write " << depfile << "\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << input << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
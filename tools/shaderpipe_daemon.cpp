@@ -0,0 +1,78 @@
+/*
+* File: shaderpipe_daemon
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+// Keeps a compiler warm behind a Unix domain socket, see ShaderDaemon. Runs until SIGINT / SIGTERM.
+//
+// usage: shaderpipe_daemon [--socket <path>] [--threads <n>] [--cache-mb <n>] [--disk-cache <dir>]
+
+#include "shader_daemon.hpp"
+#include "shader_disk_cache.hpp"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include <pthread.h>
+
+using namespace shaderpipe;
+
+int main(int argc, char** argv) {
+    DaemonOptions options;
+    std::string diskCache;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--socket" && hasValue)
+            options.socketPath = argv[++i];
+        else if (arg == "--threads" && hasValue)
+            options.threadCount = static_cast<uint32_t>(std::max(0, std::atoi(argv[++i])));
+        else if (arg == "--cache-mb" && hasValue)
+            options.cacheBytes = static_cast<uint64_t>(std::max(1, std::atoi(argv[++i]))) * 1024 * 1024;
+        else if (arg == "--disk-cache" && hasValue)
+            diskCache = argv[++i];
+        else {
+            std::cerr << "usage: shaderpipe_daemon [--socket <path>] [--threads <n>] [--cache-mb <n>] [--disk-cache <dir>]\n";
+            return 2;
+        }
+    }
+
+    // Blocked before any thread starts so every thread inherits the mask and only sigwait sees the signals.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    try {
+        CompilerSettings settings;
+        if (!diskCache.empty())
+            settings.diskCache = std::make_shared<DiskCache>(DiskCacheOptions{ diskCache });
+        Compiler compiler(settings);
+
+        ShaderDaemon daemon(compiler, options);
+        daemon.start();
+        std::cerr << "shaderpipe daemon listening on " << daemon.socket_path().string() << "\n";
+
+        int signal = 0;
+        sigwait(&signals, &signal);
+        daemon.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "Daemon failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,267 @@
+/*
+* File: shaderpipe_embed
+* Project: shader-pipe
+* Author: Collin Longoria
+* Created on: 10/17/2026
+*
+* Copyright (c) 2025 Collin Longoria
+*
+* This software is released under the MIT License.
+* https://opensource.org/licenses/MIT
+*/
+
+// Compiles one shader into a C++ header of constexpr SPIR-V and reflection tables (see shader_embedded.hpp).
+// Normally run by shaderpipe_embed_shaders in cmake/ShaderPipeEmbed.cmake rather than by hand.
+//
+// usage: shaderpipe_embed <input> -o <header> [--name <symbol>] [--namespace <name>] [--stage <ext>]
+//                         [--target <1.0..1.4>] [-I <dir>] [-D <name>[=<value>]] [-O | -Os] [--active-only]
+//                         [--depfile <file>]
+//   --name defaults to the file name with everything that can not be in an identifier replaced by '_'.
+//   --active-only leaves descriptors, inputs and outputs the entry point does not use out of the tables.
+
+#include "shader_compiler.hpp"
+#include "shader_scanner.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace shaderpipe;
+
+namespace {
+std::optional<VKVersion> parse_target(const std::string& target) {
+    constexpr const char* Names[] = { "1.0", "1.1", "1.2", "1.3", "1.4" };
+    for (uint32_t i = 0; i < std::size(Names); ++i) {
+        if (target == Names[i])
+            return static_cast<VKVersion>(i);
+    }
+    return std::nullopt;
+}
+
+int usage() {
+    std::cerr << "usage: shaderpipe_embed <input> -o <header> [--name <symbol>] [--namespace <name>] [--stage <ext>]\n"
+                 "                        [--target <1.0..1.4>] [-I <dir>] [-D <name>[=<value>]] [-O | -Os] [--active-only]\n"
+                 "                        [--depfile <file>]\n";
+    return 2;
+}
+
+std::string identifier(std::string_view name) {
+    std::string out;
+    for (char c : name)
+        out += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    if (out.empty() || std::isdigit(static_cast<unsigned char>(out[0])))
+        out.insert(out.begin(), '_');
+    return out;
+}
+
+std::string quoted(std::string_view str) {
+    std::string out = "\"";
+    for (char c : str) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out + '"';
+}
+
+const char* stage_name(ShaderStage stage) {
+    switch (stage) {
+    case ShaderStage::VERTEX:       return "VERTEX";
+    case ShaderStage::TESS_CONTROL: return "TESS_CONTROL";
+    case ShaderStage::TESS_EVAL:    return "TESS_EVAL";
+    case ShaderStage::GEOMETRY:     return "GEOMETRY";
+    case ShaderStage::FRAGMENT:     return "FRAGMENT";
+    case ShaderStage::COMPUTE:      return "COMPUTE";
+    case ShaderStage::RAYGEN:       return "RAYGEN";
+    case ShaderStage::INTERSECT:    return "INTERSECT";
+    case ShaderStage::ANY_HIT:      return "ANY_HIT";
+    case ShaderStage::CLOSEST_HIT:  return "CLOSEST_HIT";
+    case ShaderStage::MISS:         return "MISS";
+    case ShaderStage::CALLABLE:     return "CALLABLE";
+    case ShaderStage::TASK:         return "TASK";
+    case ShaderStage::MESH:         return "MESH";
+    }
+    return "VERTEX";
+}
+
+const char* scalar_name(ScalarType type) {
+    switch (type) {
+    case ScalarType::BOOL:  return "shaderpipe::ScalarType::BOOL";
+    case ScalarType::INT:   return "shaderpipe::ScalarType::INT";
+    case ScalarType::UINT:  return "shaderpipe::ScalarType::UINT";
+    case ScalarType::FLOAT: return "shaderpipe::ScalarType::FLOAT";
+    }
+    return "shaderpipe::ScalarType::FLOAT";
+}
+
+std::string hex(uint64_t value) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "0x%llxu", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+// Zero length arrays are not allowed, empty tables become an empty span instead.
+template<typename T, typename Fn>
+std::string table(std::ostream& out, const std::string& symbol, const char* type, const std::vector<T>& items, Fn write_item) {
+    if (items.empty())
+        return "{}";
+    out << "inline constexpr shaderpipe::" << type << ' ' << symbol << "[] = {\n";
+    for (const auto& item : items) {
+        out << "    { ";
+        write_item(item);
+        out << " },\n";
+    }
+    out << "};\n\n";
+    return symbol;
+}
+
+void write_header(std::ostream& out, const std::string& input, const std::string& symbol, const std::string& ns,
+                  ShaderStage stage, const CompiledShader& shader) {
+    const auto& r = shader.reflection;
+
+    out << "// Generated by shaderpipe_embed from " << input << ", do not edit.\n\n"
+        << "#pragma once\n\n"
+        << "#include <shader_embedded.hpp>\n\n";
+    if (!ns.empty())
+        out << "namespace " << ns << " {\n\n";
+
+    out << "inline constexpr uint32_t " << symbol << "_spirv[] = {";
+    for (size_t i = 0; i < shader.spirv.size(); ++i) {
+        out << (i % 8 == 0 ? "\n    " : " ");
+        char word[16];
+        std::snprintf(word, sizeof(word), "0x%08x,", shader.spirv[i]);
+        out << word;
+    }
+    out << "\n};\n\n";
+
+    const auto bindings = table(out, symbol + "_bindings", "EmbeddedDescriptorBinding", r.descriptorBindings, [&](const DescriptorBindingInfo& b) {
+        out << b.set << ", " << b.binding << ", " << quoted(b.name) << ", static_cast<VkDescriptorType>(" << static_cast<uint32_t>(b.type)
+            << "), " << b.count << ", " << hex(b.stageFlags);
+    });
+    const auto pushConstants = table(out, symbol + "_push_constants", "EmbeddedPushConstant", r.pushConstants, [&](const PushConstantInfo& p) {
+        out << p.offset << ", " << p.size << ", " << hex(p.stageFlags);
+    });
+    auto attribute = [&](const InputAttributeInfo& a) {
+        out << a.location << ", " << quoted(a.name) << ", " << a.vecSize << ", " << a.bitWidth << ", " << scalar_name(a.baseType)
+            << ", " << a.columns << ", " << a.arraySize;
+    };
+    const auto inputs = table(out, symbol + "_inputs", "EmbeddedAttribute", r.inputs, attribute);
+    const auto outputs = table(out, symbol + "_outputs", "EmbeddedAttribute", r.outputs, attribute);
+    const auto specConstants = table(out, symbol + "_spec_constants", "EmbeddedSpecConstant", r.specConstants, [&](const SpecConstantInfo& s) {
+        out << s.constantId << ", " << quoted(s.name) << ", " << scalar_name(s.type) << ", " << s.bitWidth << ", " << hex(s.defaultValue);
+    });
+
+    const auto name = std::filesystem::path(input).filename().string();
+    out << "inline constexpr shaderpipe::EmbeddedShader " << symbol << " {\n"
+        << "    " << quoted(name) << ",\n"
+        << "    shaderpipe::ShaderStage::" << stage_name(stage) << ",\n"
+        << "    " << symbol << "_spirv,\n"
+        << "    " << bindings << ",\n"
+        << "    " << pushConstants << ",\n"
+        << "    " << inputs << ",\n"
+        << "    " << outputs << ",\n"
+        << "    " << specConstants << ",\n"
+        << "};\n";
+
+    if (!ns.empty())
+        out << "\n} // namespace " << ns << "\n";
+}
+}
+
+int main(int argc, char** argv) {
+    std::string input, output, symbol, ns, depfile;
+    std::optional<ShaderStage> stage;
+    VKVersion target = VKVersion::VK_1_3;
+    CompileOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue)
+            output = argv[++i];
+        else if (arg == "--name" && hasValue)
+            symbol = identifier(argv[++i]);
+        else if (arg == "--namespace" && hasValue)
+            ns = argv[++i];
+        else if (arg == "--stage" && hasValue) {
+            if (!(stage = stage_from_extension(std::string("x.") + argv[++i])))
+                return usage();
+        } else if (arg == "--target" && hasValue) {
+            auto version = parse_target(argv[++i]);
+            if (!version)
+                return usage();
+            target = *version;
+        } else if (arg == "-I" && hasValue)
+            options.includeDirectories.emplace_back(argv[++i]);
+        else if (arg == "-D" && hasValue) {
+            const std::string define = argv[++i];
+            const auto eq = define.find('=');
+            options.defines.push_back({ define.substr(0, eq), eq == std::string::npos ? std::string() : define.substr(eq + 1) });
+        } else if (arg == "-O")
+            options.optimization.level = OptimizationLevel::PERFORMANCE;
+        else if (arg == "-Os")
+            options.optimization.level = OptimizationLevel::SIZE;
+        else if (arg == "--active-only")
+            options.reflection.activeOnly = true;
+        else if (arg == "--depfile" && hasValue)
+            depfile = argv[++i];
+        else if (input.empty() && !arg.empty() && arg[0] != '-')
+            input = arg;
+        else
+            return usage();
+    }
+    if (input.empty() || output.empty())
+        return usage();
+    if (symbol.empty())
+        symbol = identifier(std::filesystem::path(input).filename().string());
+
+    try {
+        const auto deps = DependencyScanner(options.includeDirectories).scan(input);
+        if (!stage && !(stage = deps.info.stage)) {
+            std::cerr << "Can not tell the shader stage of " << input << ", pass --stage.\n";
+            return 2;
+        }
+
+        options.sourcePath = input;
+        const auto source = load_shader_file(input);
+        const auto shader = default_compiler().glsl_to_spirv_with_reflection(source, *stage, target, options);
+
+        // Built in memory first so a failed compile never leaves a truncated header behind.
+        std::ostringstream header;
+        write_header(header, input, symbol, ns, *stage, shader);
+
+        // Written next to the output and renamed over it: a tool killed halfway, or a full disk, must not leave a
+        // truncated header behind with a fresh mtime that the build then takes as up to date.
+        const auto tmp = std::filesystem::path(output + ".tmp." + std::to_string(std::random_device{}()));
+        std::error_code ec;
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            out << header.str();
+            out.close();
+            if (!out.good()) {
+                std::filesystem::remove(tmp, ec);
+                std::cerr << "Could not write " << output << "\n";
+                return 1;
+            }
+        }
+        std::filesystem::rename(tmp, output, ec);
+        if (ec) {
+            std::cerr << "Could not write " << output << ": " << ec.message() << "\n";
+            std::filesystem::remove(tmp, ec);
+            return 1;
+        }
+        if (!depfile.empty() && !write_depfile(depfile, output, deps)) {
+            std::cerr << "Could not write " << depfile << "\n";
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << input << ": " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}